@@ -0,0 +1,240 @@
+// src/cpp/daemon/daemon_client.cpp
+#include "daemon_client.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+DaemonClient::DaemonClient()
+    : fd(-1),
+      credit(0),
+      frame_bytes(sizeof(int16_t)) {
+}
+
+DaemonClient::~DaemonClient() {
+    Close();
+}
+
+bool DaemonClient::Connect(const std::string& socket_path) {
+    Close();
+
+    sockaddr_un addr{};
+    if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)) {
+        return Fail("소켓 경로가 비어 있거나 너무 깁니다");
+    }
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return Fail("소켓 생성 실패: " + std::string(std::strerror(errno)));
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size());
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::string message = "데몬 연결 실패: " + std::string(std::strerror(errno));
+        Close();
+        return Fail(message);
+    }
+    return true;
+}
+
+bool DaemonClient::CreateSession(const std::string& sentence, int sample_rate, int channels, uint8_t flags) {
+    if (fd < 0) {
+        return Fail("연결되지 않았습니다");
+    }
+    if (sample_rate <= 0 || channels <= 0 || channels > 0xFFFF) {
+        return Fail("잘못된 오디오 형식입니다");
+    }
+
+    scratch.clear();
+    PutU32(scratch, static_cast<uint32_t>(sample_rate));
+    PutU16(scratch, static_cast<uint16_t>(channels));
+    scratch += static_cast<char>(flags);
+    scratch += sentence;
+    if (!WriteFrame(fd, FrameType::CREATE_SESSION, scratch.data(), scratch.size())) {
+        return Fail("CREATE_SESSION 전송 실패");
+    }
+
+    if (!ReadFrame(fd, frame)) {
+        return Fail("데몬 연결이 끊겼습니다");
+    }
+    if (frame.type == FrameType::ERROR) {
+        return Fail(frame.payload);
+    }
+    if (frame.type != FrameType::SESSION_READY || frame.payload.size() < 4) {
+        return Fail("예상하지 못한 응답입니다");
+    }
+
+    credit = GetU32(frame.payload.data());
+    frame_bytes = static_cast<size_t>(channels) * sizeof(int16_t);
+    return true;
+}
+
+void DaemonClient::SetScoreCallback(ScoreCallback on_score) {
+    this->on_score = std::move(on_score);
+}
+
+bool DaemonClient::SendAudio(const int16_t* interleaved, size_t frames, int timeout_ms) {
+    if (fd < 0) {
+        return Fail("연결되지 않았습니다");
+    }
+
+    // 한 프레임이 최대 페이로드와 초기 크레딧을 넘지 않도록 나눠 보낸다
+    const char* data = reinterpret_cast<const char*>(interleaved);
+    size_t remaining = frames * frame_bytes;
+    size_t max_chunk = (kMaxFramePayload / frame_bytes) * frame_bytes;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+    while (remaining > 0) {
+        // 크레딧이 한 오디오 프레임도 안 되면 CREDIT가 올 때까지 대기
+        while (credit < frame_bytes) {
+            int wait_ms = -1;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) {
+                    return Fail("크레딧 대기 시간 초과");
+                }
+                wait_ms = static_cast<int>(left);
+            }
+            if (!Poll(wait_ms)) {
+                return false;
+            }
+        }
+
+        size_t chunk = std::min(std::min(remaining, max_chunk), (credit / frame_bytes) * frame_bytes);
+        if (!WriteFrame(fd, FrameType::AUDIO, data, chunk)) {
+            return Fail("AUDIO 전송 실패");
+        }
+        credit -= chunk;
+        data += chunk;
+        remaining -= chunk;
+    }
+    return true;
+}
+
+bool DaemonClient::AttachSharedMemory(const ShmAudioProducer& producer) {
+    if (fd < 0) {
+        return Fail("연결되지 않았습니다");
+    }
+
+    int fds[2] = {producer.MemoryFd(), producer.EventFd()};
+    if (fds[0] < 0 || fds[1] < 0) {
+        return Fail("공유 메모리 링이 생성되지 않았습니다");
+    }
+    if (!WriteFrameWithFds(fd, FrameType::ATTACH_SHM, fds, 2)) {
+        return Fail("ATTACH_SHM 전송 실패");
+    }
+    return true;
+}
+
+bool DaemonClient::RequestSnapshot() {
+    if (fd < 0 || !WriteFrame(fd, FrameType::SNAPSHOT)) {
+        return Fail("SNAPSHOT 전송 실패");
+    }
+    return true;
+}
+
+bool DaemonClient::Poll(int timeout_ms) {
+    if (fd < 0) {
+        return Fail("연결되지 않았습니다");
+    }
+
+    // 첫 프레임만 timeout_ms까지 기다리고, 이미 도착한 나머지는 바로 처리
+    int wait_ms = timeout_ms;
+    while (WaitReadable(wait_ms)) {
+        if (!ReadOne()) {
+            return false;
+        }
+        wait_ms = 0;
+    }
+    return fd >= 0;
+}
+
+bool DaemonClient::Finish(std::string& result) {
+    if (fd < 0 || !WriteFrame(fd, FrameType::FINISH)) {
+        return Fail("FINISH 전송 실패");
+    }
+
+    while (ReadFrame(fd, frame)) {
+        if (frame.type == FrameType::RESULT) {
+            result.swap(frame.payload);
+            Close();
+            return true;
+        }
+        if (frame.type == FrameType::ERROR) {
+            std::string message = frame.payload;
+            Close();
+            return Fail(message);
+        }
+        if (frame.type == FrameType::SCORE && on_score) {
+            on_score(frame.payload);
+        }
+    }
+
+    Close();
+    return Fail("결과 수신 전에 연결이 끊겼습니다");
+}
+
+void DaemonClient::Close() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    credit = 0;
+}
+
+bool DaemonClient::ReadOne() {
+    if (!ReadFrame(fd, frame)) {
+        Close();
+        return Fail("데몬 연결이 끊겼습니다");
+    }
+
+    switch (frame.type) {
+        case FrameType::SCORE:
+            if (on_score) {
+                on_score(frame.payload);
+            }
+            return true;
+        case FrameType::CREDIT:
+            if (frame.payload.size() >= 4) {
+                credit += GetU32(frame.payload.data());
+            }
+            return true;
+        case FrameType::ERROR: {
+            std::string message = frame.payload;
+            Close();
+            return Fail(message);
+        }
+        default:
+            return true;
+    }
+}
+
+bool DaemonClient::WaitReadable(int timeout_ms) {
+    pollfd pfd{};
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+
+    return ready > 0;
+}
+
+bool DaemonClient::Fail(const std::string& message) {
+    last_error = message;
+    return false;
+}
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -0,0 +1,64 @@
+// src/cpp/daemon/daemon_client.h
+#pragma once
+
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "daemon_protocol.h"
+#include "shm_audio_ring.h"
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+// 스코어링 데몬 클라이언트. 엔진/모델 의존성이 없어 앱 프로세스에 가볍게 링크할 수 있다.
+// 한 인스턴스가 하나의 세션(연결)이며, 스레드 안전하지 않다.
+class DaemonClient {
+public:
+    // 점수 이벤트 페이로드 (세션 인코딩에 따라 JSON 또는 길이 접두 MessagePack)
+    using ScoreCallback = std::function<void(const std::string&)>;
+
+    DaemonClient();
+    ~DaemonClient();
+
+    DaemonClient(const DaemonClient&) = delete;
+    DaemonClient& operator=(const DaemonClient&) = delete;
+
+    bool Connect(const std::string& socket_path);
+    // SESSION_READY를 받을 때까지 대기. flags는 kSessionFlag* 조합
+    bool CreateSession(const std::string& sentence, int sample_rate = 16000, int channels = 1, uint8_t flags = 0);
+    void SetScoreCallback(ScoreCallback on_score);
+
+    // 인터리브 s16 PCM 전송. 크레딧이 부족하면 데몬 이벤트를 처리하며 timeout_ms까지 기다린다
+    // (timeout_ms < 0이면 무한 대기, 0이면 즉시 반환). 시간 초과/오류면 false
+    bool SendAudio(const int16_t* interleaved, size_t frames, int timeout_ms = -1);
+    // 공유 메모리 링으로 오디오를 보내도록 전환한다 (CreateSession 후, 형식이 세션과 같아야 함).
+    // 이후 오디오는 producer.Write로 직접 기록하고, 점수 이벤트는 Poll/Finish로 받는다.
+    bool AttachSharedMemory(const ShmAudioProducer& producer);
+    bool RequestSnapshot();
+    // 도착한 이벤트(SCORE/CREDIT)를 처리한다. 오류/연결 종료면 false
+    bool Poll(int timeout_ms = 0);
+    // 남은 오디오 평가 후 최종 결과(RESULT 페이로드)를 받고 연결을 닫는다
+    bool Finish(std::string& result);
+    void Close();
+
+    size_t Credit() const { return credit; }
+    const std::string& LastError() const { return last_error; }
+
+private:
+    bool ReadOne();
+    bool WaitReadable(int timeout_ms);
+    bool Fail(const std::string& message);
+
+    int fd;
+    size_t credit;
+    size_t frame_bytes;
+    ScoreCallback on_score;
+    Frame frame;          // 수신 재사용 버퍼
+    std::string scratch;  // 송신 재사용 버퍼
+    std::string last_error;
+};
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -0,0 +1,190 @@
+// src/cpp/daemon/daemon_protocol.cpp
+#include "daemon_protocol.h"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+namespace {
+
+bool ReadFully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+bool WriteFrame(int fd, FrameType type, const void* payload, size_t size) {
+    return WriteFrameWithFds(fd, type, nullptr, 0, payload, size);
+}
+
+bool WriteFrameWithFds(int fd, FrameType type, const int* fds, size_t num_fds,
+                       const void* payload, size_t size) {
+    if (size > kMaxFramePayload || num_fds > kMaxFrameFds) {
+        return false;
+    }
+
+    char header[kFrameHeaderSize];
+    uint32_t length = static_cast<uint32_t>(size);
+    header[0] = static_cast<char>((length >> 24) & 0xFF);
+    header[1] = static_cast<char>((length >> 16) & 0xFF);
+    header[2] = static_cast<char>((length >> 8) & 0xFF);
+    header[3] = static_cast<char>(length & 0xFF);
+    header[4] = static_cast<char>(type);
+
+    iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = const_cast<void*>(payload);
+    iov[1].iov_len = size;
+
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = size > 0 ? 2 : 1;
+
+    // fd는 첫 sendmsg에만 싣는다 (스트림 소켓에서는 첫 바이트와 함께 전달됨)
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFrameFds)];
+    if (num_fds > 0) {
+        std::memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * num_fds);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * num_fds);
+        std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * num_fds);
+    }
+
+    // 부분 전송 시 남은 iovec부터 이어서 보낸다
+    while (msg.msg_iovlen > 0) {
+        ssize_t n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return false;
+        }
+
+        msg.msg_control = nullptr;
+        msg.msg_controllen = 0;
+
+        size_t sent = static_cast<size_t>(n);
+        while (msg.msg_iovlen > 0 && sent >= msg.msg_iov[0].iov_len) {
+            sent -= msg.msg_iov[0].iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov[0].iov_base = static_cast<char*>(msg.msg_iov[0].iov_base) + sent;
+            msg.msg_iov[0].iov_len -= sent;
+        }
+    }
+    return true;
+}
+
+bool ReadFrame(int fd, Frame& frame) {
+    CloseFrameFds(frame);
+
+    // 헤더 첫 부분은 recvmsg로 읽어 함께 온 fd를 받는다
+    char header[kFrameHeaderSize];
+    iovec iov;
+    iov.iov_base = header;
+    iov.iov_len = sizeof(header);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFrameFds)];
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        return false;
+    }
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t i = 0; i < count; ++i) {
+                int received;
+                std::memcpy(&received, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                if (frame.num_fds < kMaxFrameFds) {
+                    frame.fds[frame.num_fds++] = received;
+                } else {
+                    close(received);
+                }
+            }
+        }
+    }
+
+    size_t received_bytes = static_cast<size_t>(n);
+    if (received_bytes < sizeof(header) &&
+        !ReadFully(fd, header + received_bytes, sizeof(header) - received_bytes)) {
+        return false;
+    }
+
+    uint32_t length = GetU32(header);
+    if (length > kMaxFramePayload) {
+        return false;
+    }
+
+    frame.type = static_cast<FrameType>(static_cast<uint8_t>(header[4]));
+    frame.payload.resize(length);
+    return length == 0 || ReadFully(fd, &frame.payload[0], length);
+}
+
+Frame::~Frame() {
+    CloseFrameFds(*this);
+}
+
+void CloseFrameFds(Frame& frame) {
+    for (size_t i = 0; i < frame.num_fds; ++i) {
+        close(frame.fds[i]);
+        frame.fds[i] = -1;
+    }
+    frame.num_fds = 0;
+}
+
+void PutU16(std::string& out, uint16_t value) {
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>(value & 0xFF);
+}
+
+void PutU32(std::string& out, uint32_t value) {
+    out += static_cast<char>((value >> 24) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>(value & 0xFF);
+}
+
+uint16_t GetU16(const char* data) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t GetU32(const char* data) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -0,0 +1,64 @@
+// src/cpp/daemon/daemon_protocol.h
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+// 프레임 형식: [페이로드 길이 u32 big-endian][타입 u8][페이로드]
+constexpr size_t kFrameHeaderSize = 5;
+constexpr uint32_t kMaxFramePayload = 1u << 20;  // 1 MiB
+constexpr size_t kMaxFrameFds = 2;               // 프레임 하나에 실을 수 있는 fd 수
+
+enum class FrameType : uint8_t {
+    // 클라이언트 -> 데몬
+    CREATE_SESSION = 1,  // [샘플 레이트 u32][채널 수 u16][플래그 u8][문장 UTF-8]
+    AUDIO = 2,           // s16le 인터리브 PCM (전송 전 크레딧 필요)
+    FINISH = 3,          // 남은 오디오를 평가하고 RESULT 후 연결 종료
+    SNAPSHOT = 4,        // 델타 모드에서 다음 SCORE를 스냅샷으로 요청
+    ATTACH_SHM = 5,      // 공유 메모리 링 연결: SCM_RIGHTS로 [메모리 fd, eventfd] 전달, 이후 AUDIO 대신 링 사용
+
+    // 데몬 -> 클라이언트
+    SESSION_READY = 64,  // [초기 크레딧 바이트 u32]
+    SCORE = 65,          // on_score 이벤트 그대로 (JSON 또는 길이 접두 MessagePack)
+    CREDIT = 66,         // [반환 크레딧 바이트 u32] - 세션 스케줄러 대기열이 상한 이하가 된 뒤 전송
+    RESULT = 67,         // 최종 상태 (GetCurrentState 형식, 세션 인코딩)
+    ERROR = 127          // UTF-8 오류 메시지, 이후 연결 종료
+};
+
+// CREATE_SESSION 플래그
+constexpr uint8_t kSessionFlagDelta = 0x01;    // ScoreEventMode::DELTA
+constexpr uint8_t kSessionFlagMsgpack = 0x02;  // ResultEncoding::MSGPACK
+
+struct Frame {
+    Frame() = default;
+    ~Frame();
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+
+    FrameType type = FrameType::ERROR;
+    std::string payload;  // 연결마다 재사용 (capacity 유지)
+    int fds[kMaxFrameFds] = {-1, -1};  // SCM_RIGHTS로 받은 fd
+    size_t num_fds = 0;   // 소유권을 가져가면 0으로 (남은 fd는 다음 ReadFrame에서 닫힌다)
+};
+
+// 프레임 하나를 모두 보낸다 (헤더와 페이로드를 한 번의 sendmsg로, SIGPIPE 없이)
+bool WriteFrame(int fd, FrameType type, const void* payload = nullptr, size_t size = 0);
+// fd를 함께 보낸다 (SCM_RIGHTS, 최대 kMaxFrameFds개)
+bool WriteFrameWithFds(int fd, FrameType type, const int* fds, size_t num_fds,
+                       const void* payload = nullptr, size_t size = 0);
+// 프레임 하나를 모두 읽는다. EOF, 오류, 최대 크기 초과면 false
+bool ReadFrame(int fd, Frame& frame);
+// 가져가지 않은 fd를 닫는다
+void CloseFrameFds(Frame& frame);
+
+void PutU16(std::string& out, uint16_t value);
+void PutU32(std::string& out, uint32_t value);
+uint16_t GetU16(const char* data);
+uint32_t GetU32(const char* data);
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -0,0 +1,138 @@
+// src/cpp/daemon/gop_daemon.cpp
+// 모델을 한 번 로드해 두고 Unix 도메인 소켓으로 여러 앱 프로세스의 평가 세션을 처리하는 데몬.
+// 프로토콜은 daemon_protocol.h, 클라이언트는 daemon_client.h 참고. SIGINT/SIGTERM으로 종료한다.
+#include "scoring_daemon.h"
+#include "realtime_engine_ko/reactor.h"
+#include <iostream>
+#include <string>
+#include <memory>
+#include <csignal>
+#include <cstdlib>
+#include <algorithm>
+#include <pthread.h>
+
+using namespace realtime_engine_ko;
+
+namespace {
+
+void PrintUsage(const char* program) {
+    std::cerr << "사용법: " << program << " --model <onnx> --tokenizer <tokenizer.json>\n"
+              << "        [--socket <path>] [--max-sessions N] [--credit BYTES] [--device CPU]\n"
+              << "        [--confidence-threshold T] [--threads N] [--latency-slo SEC] [--drop-after SEC]\n"
+              << "        [--max-pending-chunks N] [--reactor-threads N] [--plan-store <path>] [--plan-cache-mb N]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string model_path;
+    std::string tokenizer_path;
+    std::string device = "CPU";
+    daemon::DaemonOptions options;
+    size_t reactor_threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](std::string& value) {
+            if (i + 1 >= argc) {
+                PrintUsage(argv[0]);
+                std::exit(2);
+            }
+            value = argv[++i];
+        };
+
+        std::string value;
+        try {
+            if (arg == "--model") {
+                next(model_path);
+            } else if (arg == "--tokenizer") {
+                next(tokenizer_path);
+            } else if (arg == "--socket") {
+                next(options.socket_path);
+            } else if (arg == "--device") {
+                next(device);
+            } else if (arg == "--max-sessions") {
+                next(value);
+                options.max_sessions = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (arg == "--credit") {
+                next(value);
+                options.initial_credit = static_cast<uint32_t>(std::max(4096L, std::stol(value)));
+            } else if (arg == "--confidence-threshold") {
+                next(value);
+                options.confidence_threshold = std::stof(value);
+            } else if (arg == "--threads") {
+                next(value);
+                options.scheduler_threads = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (arg == "--latency-slo") {
+                next(value);
+                options.latency_slo = std::stof(value);
+            } else if (arg == "--drop-after") {
+                next(value);
+                options.drop_after = std::stof(value);
+            } else if (arg == "--max-pending-chunks") {
+                next(value);
+                options.max_pending_chunks = static_cast<size_t>(std::max(0, std::stoi(value)));
+            } else if (arg == "--reactor-threads") {
+                next(value);
+                reactor_threads = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (arg == "--plan-store") {
+                next(options.plan_store_path);
+            } else if (arg == "--plan-cache-mb") {
+                next(value);
+                options.plan_cache_bytes = static_cast<size_t>(std::max(1, std::stoi(value))) << 20;
+            } else if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            } else {
+                std::cerr << "알 수 없는 옵션: " << arg << "\n";
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        } catch (const std::exception&) {
+            // std::stoi/stol/stof: 숫자가 아니거나 범위를 벗어난 값
+            std::cerr << "잘못된 값: " << arg << " " << value << "\n";
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (model_path.empty() || tokenizer_path.empty()) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    // 종료 시그널은 메인 스레드에서 sigwait로 받는다 (이후 생성되는 스레드는 마스크를 상속)
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    // 모델은 한 번만 로드하고 모든 세션이 공유한다
+    std::shared_ptr<Wav2VecCTCOnnxCore> engine;
+    try {
+        engine = std::make_shared<Wav2VecCTCOnnxCore>(model_path, tokenizer_path, device);
+    } catch (const std::exception& e) {
+        std::cerr << "모델 로드 실패: " << e.what() << "\n";
+        return 1;
+    }
+
+    // 세션 틱/파일 감시는 프로세스 공유 Reactor 하나로 처리한다 (시그널 마스크를 상속하도록 마스크 설정 뒤 생성)
+    Reactor::Options reactor_options;
+    reactor_options.num_threads = reactor_threads;
+    Reactor::SetShared(std::make_shared<Reactor>(reactor_options));
+
+    daemon::ScoringDaemon scoring_daemon(engine, options);
+    if (!scoring_daemon.Start()) {
+        Reactor::SetShared(nullptr);
+        return 1;
+    }
+
+    int signal_number = 0;
+    sigwait(&signals, &signal_number);
+    std::cerr << "종료 시그널 수신 (" << signal_number << "), 세션 " << scoring_daemon.ActiveSessions() << "개 정리 중\n";
+    scoring_daemon.Stop();
+    Reactor::SetShared(nullptr);
+
+    return 0;
+}
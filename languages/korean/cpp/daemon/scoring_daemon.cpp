@@ -0,0 +1,479 @@
+// src/cpp/daemon/scoring_daemon.cpp
+#include "scoring_daemon.h"
+#include "daemon_protocol.h"
+#include "shm_audio_ring.h"
+#include "realtime_engine_ko/recognition_engine.h"
+#include "realtime_engine_ko/common.h"
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <mutex>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+namespace {
+
+void SendError(int fd, const std::string& message) {
+    WriteFrame(fd, FrameType::ERROR, message.data(), message.size());
+}
+
+// 흐름 제어 대기 중에도 쌓인 점수를 보내도록 깨어나는 주기
+constexpr double kBacklogWaitSeconds = 0.02;
+
+// 세션 소켓 쓰기 (세션 스레드에서만 호출한다)
+class SessionWriter {
+public:
+    explicit SessionWriter(int fd) : fd(fd) {}
+
+    bool Send(FrameType type, const std::string& payload) {
+        return WriteFrame(fd, type, payload.data(), payload.size());
+    }
+
+    void Error(const std::string& message) {
+        Send(FrameType::ERROR, message);
+    }
+
+private:
+    int fd;
+};
+
+// 스케줄러 작업자가 만든 점수 이벤트를 세션 스레드로 넘긴다.
+// 작업자는 큐에 넣고 eventfd만 울리므로 느린 클라이언트의 소켓 쓰기가 추론을 막지 않는다
+class ScoreOutbox {
+public:
+    ScoreOutbox() : event_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+        if (event_fd < 0) {
+            throw std::runtime_error("점수 eventfd 생성 실패: " + std::string(std::strerror(errno)));
+        }
+    }
+    ~ScoreOutbox() { close(event_fd); }
+
+    ScoreOutbox(const ScoreOutbox&) = delete;
+    ScoreOutbox& operator=(const ScoreOutbox&) = delete;
+
+    void Push(const std::string& event) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event);
+        }
+        uint64_t one = 1;
+        ssize_t written = write(event_fd, &one, sizeof(one));
+        (void)written;  // 카운터가 가득 차도 이미 읽을 수 있는 상태다
+    }
+
+    // 쌓인 이벤트를 순서대로 보낸다. 쓰기 실패면 false
+    bool Flush(SessionWriter& writer) {
+        uint64_t count;
+        ssize_t drained = read(event_fd, &count, sizeof(count));
+        (void)drained;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sending.swap(events);
+        }
+        for (const auto& event : sending) {
+            if (!writer.Send(FrameType::SCORE, event)) {
+                return false;
+            }
+        }
+        sending.clear();
+        return true;
+    }
+
+    int EventFd() const { return event_fd; }
+
+private:
+    int event_fd;
+    std::mutex mutex;
+    std::deque<std::string> events;   // mutex 보호
+    std::deque<std::string> sending;  // 세션 스레드 전용
+};
+
+// 스케줄러에 쌓인 세션 청크가 상한 이하가 될 때까지 기다리며, 그동안 나온 점수는 계속 보낸다. 쓰기 실패면 false
+bool WaitForBacklog(EngineCoordinator& coordinator, size_t max_pending, ScoreOutbox& outbox, SessionWriter& writer) {
+    while (!coordinator.WaitForPendingChunks(max_pending, kBacklogWaitSeconds)) {
+        if (!outbox.Flush(writer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 링에 쌓인 PCM을 복사 없이 코디네이터로 넘긴다 (링 끝에서 나뉘면 두 번).
+// 스케줄러 대기열이 차 있으면 링을 소비하지 않고 기다려 생산자 쪽 링이 차게 둔다. 쓰기 실패면 false
+bool DrainRing(ShmAudioConsumer& ring, EngineCoordinator& coordinator, size_t max_pending,
+               ScoreOutbox& outbox, SessionWriter& writer) {
+    const float* data;
+    size_t frames;
+    while ((frames = ring.ReadableSpan(&data)) > 0) {
+        if (!WaitForBacklog(coordinator, max_pending, outbox, writer)) {
+            return false;
+        }
+        coordinator.PushAudio(data, frames);
+        ring.Consume(frames);
+    }
+    return true;
+}
+
+// 소켓에 읽을 프레임이 올 때까지 점수를 보내고 링 오디오(연결되어 있으면)를 넘긴다.
+// 소켓을 읽을 차례면 true, 소켓 쓰기 실패면 false
+bool WaitForSocket(int fd, ShmAudioConsumer* ring, EngineCoordinator& coordinator, size_t max_pending,
+                   ScoreOutbox& outbox, SessionWriter& writer) {
+    while (true) {
+        if (!outbox.Flush(writer)) {
+            return false;
+        }
+
+        bool wait_ring = false;
+        if (ring) {
+            // 닫힘을 먼저 확인해야 닫기 직전에 쓰인 오디오까지 이번에 비운다
+            bool closed = ring->IsClosed();
+            if (!DrainRing(*ring, coordinator, max_pending, outbox, writer)) {
+                return false;
+            }
+            wait_ring = !closed && ring->PrepareWait();
+            if (!closed && !wait_ring) {
+                continue;  // 대기 표시 전후로 오디오가 들어옴
+            }
+        }
+
+        pollfd fds[3];
+        fds[0].fd = fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = outbox.EventFd();
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if (wait_ring) {
+            fds[2].fd = ring->EventFd();
+            fds[2].events = POLLIN;
+            fds[2].revents = 0;
+        }
+
+        int ready;
+        do {
+            ready = poll(fds, wait_ring ? 3 : 2, -1);
+        } while (ready < 0 && errno == EINTR);
+
+        if (wait_ring) {
+            ring->FinishWait();
+        }
+        if (ready < 0 || fds[0].revents != 0) {
+            return true;  // 오류면 ReadFrame이 실패해 세션을 끝낸다
+        }
+    }
+}
+
+} // namespace
+
+ScoringDaemon::ScoringDaemon(std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine, const DaemonOptions& options)
+    : recognition_engine(recognition_engine),
+      options(options),
+      listen_fd(-1),
+      is_running(false) {
+}
+
+ScoringDaemon::~ScoringDaemon() {
+    Stop();
+}
+
+bool ScoringDaemon::Start() {
+    if (is_running) {
+        return true;
+    }
+
+    sockaddr_un addr{};
+    if (options.socket_path.empty() || options.socket_path.size() >= sizeof(addr.sun_path)) {
+        LOG_ERROR("ScoringDaemon", "소켓 경로가 비어 있거나 너무 깁니다: " + options.socket_path);
+        return false;
+    }
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        LOG_ERROR("ScoringDaemon", "소켓 생성 실패: " + std::string(std::strerror(errno)));
+        return false;
+    }
+
+    // 이전 실행이 남긴 소켓 파일 제거
+    unlink(options.socket_path.c_str());
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, options.socket_path.c_str(), options.socket_path.size());
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd, static_cast<int>(options.max_sessions)) < 0) {
+        LOG_ERROR("ScoringDaemon", "소켓 바인드 실패 (" + options.socket_path + "): " + std::string(std::strerror(errno)));
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    // 모든 세션의 청크 추론은 하나의 EDF 스케줄러를 공유한다
+    if (!scheduler) {
+        InferenceScheduler::Options scheduler_options;
+        scheduler_options.num_threads = options.scheduler_threads;
+        scheduler_options.drop_after_seconds = options.drop_after;
+        scheduler = std::make_shared<InferenceScheduler>(scheduler_options);
+    }
+
+    // 세션 설정이 해시 조회가 되도록 문장 계획 캐시를 미리 채운다
+    auto plan_cache = PlanCache::Global();
+    plan_cache->SetMaxBytes(options.plan_cache_bytes);
+    if (!options.plan_store_path.empty()) {
+        plan_cache->Preload(*recognition_engine, options.plan_store_path);
+    }
+
+    is_running = true;
+    accept_thread = std::make_unique<std::thread>(&ScoringDaemon::AcceptLoop, this);
+
+    LOG_INFO("ScoringDaemon", "데몬 시작: " + options.socket_path);
+    return true;
+}
+
+void ScoringDaemon::Stop() {
+    if (!is_running.exchange(false)) {
+        return;
+    }
+
+    // 리스닝 소켓을 shutdown하면 블로킹된 accept가 깨어난다
+    shutdown(listen_fd, SHUT_RDWR);
+    if (accept_thread && accept_thread->joinable()) {
+        accept_thread->join();
+        accept_thread.reset();
+    }
+    close(listen_fd);
+    listen_fd = -1;
+    unlink(options.socket_path.c_str());
+
+    // 세션 스레드는 소켓 읽기에서 깨어나 스스로 정리한다
+    std::unique_lock<std::mutex> lock(sessions_mutex);
+    for (int fd : session_fds) {
+        shutdown(fd, SHUT_RDWR);
+    }
+    sessions_cv.wait(lock, [this] { return session_fds.empty(); });
+    lock.unlock();
+
+    if (!options.plan_store_path.empty()) {
+        PlanCache::Global()->Save(*recognition_engine, options.plan_store_path);
+    }
+
+    auto stats = PlanCache::Global()->GetStats();
+    std::stringstream ss;
+    ss << "데몬 종료 (문장 계획 캐시: " << stats.entries << "개, " << stats.bytes << " 바이트, 적중 "
+       << stats.hits << " / 실패 " << stats.misses << ")";
+    LOG_INFO("ScoringDaemon", ss.str());
+}
+
+size_t ScoringDaemon::ActiveSessions() const {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    return session_fds.size();
+}
+
+void ScoringDaemon::AcceptLoop() {
+    while (is_running) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (is_running) {
+                LOG_ERROR("ScoringDaemon", "accept 실패: " + std::string(std::strerror(errno)));
+            }
+            break;
+        }
+
+        bool accepted = false;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex);
+            if (is_running && session_fds.size() < options.max_sessions) {
+                session_fds.insert(fd);
+                accepted = true;
+            }
+        }
+        if (!accepted) {
+            SendError(fd, "세션 수 한도 초과");
+            close(fd);
+            continue;
+        }
+
+        // 세션 스레드는 분리하고, 종료는 session_fds로 추적한다
+        std::thread(&ScoringDaemon::HandleConnection, this, fd).detach();
+    }
+}
+
+void ScoringDaemon::HandleConnection(int fd) {
+    try {
+        RunSession(fd);
+    } catch (const std::exception& e) {
+        LOG_ERROR("ScoringDaemon", "세션 오류: " + std::string(e.what()));
+        SendError(fd, e.what());
+    }
+
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    close(fd);
+    session_fds.erase(fd);
+    sessions_cv.notify_all();
+}
+
+bool ScoringDaemon::RunSession(int fd) {
+    Frame frame;
+    if (!ReadFrame(fd, frame)) {
+        return false;
+    }
+    if (frame.type != FrameType::CREATE_SESSION || frame.payload.size() < 7) {
+        SendError(fd, "CREATE_SESSION 프레임이 필요합니다");
+        return false;
+    }
+
+    int sample_rate = static_cast<int>(GetU32(frame.payload.data()));
+    int channels = GetU16(frame.payload.data() + 4);
+    uint8_t flags = static_cast<uint8_t>(frame.payload[6]);
+    std::string sentence = frame.payload.substr(7);
+    bool binary = (flags & kSessionFlagMsgpack) != 0;
+
+    // 모델은 공유하고, 문장 블록/평가 상태는 세션마다 따로 둔다
+    SessionWriter writer(fd);
+    ScoreOutbox outbox;  // coordinator보다 먼저 선언 (작업자가 끝난 뒤 소멸)
+    EngineCoordinator coordinator(recognition_engine, 0.3f, options.confidence_threshold);
+    coordinator.SetInferenceScheduler(scheduler, options.latency_slo);
+    coordinator.SetScoreEventMode((flags & kSessionFlagDelta) ? ScoreEventMode::DELTA : ScoreEventMode::FULL);
+    coordinator.SetResultEncoding(binary ? ResultEncoding::MSGPACK : ResultEncoding::JSON);
+
+    // on_score는 스케줄러 작업자 스레드에서 실행되므로 큐에만 넣고, 소켓 쓰기는 세션 스레드가 한다
+    RecordListener listener;
+    listener.on_score = [&outbox](const std::string& event) {
+        outbox.Push(event);
+    };
+    coordinator.SetRecordListener(listener);
+
+    if (!coordinator.StartStream(sentence, sample_rate, channels)) {
+        writer.Error("세션 초기화 실패");
+        return false;
+    }
+
+    std::string reply;
+    PutU32(reply, options.initial_credit);
+    if (!writer.Send(FrameType::SESSION_READY, reply)) {
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << "세션 시작 (fd=" << fd << ", " << sample_rate << "Hz, " << channels << "ch)";
+    LOG_INFO("ScoringDaemon", ss.str());
+
+    uint32_t credit = options.initial_credit;
+    size_t frame_bytes = static_cast<size_t>(channels) * sizeof(int16_t);
+    std::vector<float> pcm;  // s16 -> float 변환 재사용 버퍼
+    std::unique_ptr<ShmAudioConsumer> ring;  // ATTACH_SHM 이후 오디오 입력
+
+    while (true) {
+        if (!WaitForSocket(fd, ring.get(), coordinator, options.max_pending_chunks, outbox, writer)) {
+            break;
+        }
+        if (!ReadFrame(fd, frame)) {
+            break;
+        }
+
+        switch (frame.type) {
+            case FrameType::AUDIO: {
+                if (ring) {
+                    writer.Error("공유 메모리 링 연결 후에는 AUDIO를 보낼 수 없습니다");
+                    return false;
+                }
+                uint32_t size = static_cast<uint32_t>(frame.payload.size());
+                if (size > credit) {
+                    writer.Error("크레딧 초과 전송");
+                    return false;
+                }
+                if (size % frame_bytes != 0) {
+                    writer.Error("AUDIO 크기가 프레임 단위가 아닙니다");
+                    return false;
+                }
+                credit -= size;
+
+                size_t samples = size / sizeof(int16_t);
+                pcm.resize(samples);
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(frame.payload.data());
+                for (size_t i = 0; i < samples; ++i) {
+                    int16_t sample = static_cast<int16_t>(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+                    pcm[i] = static_cast<float>(sample) / 32768.0f;
+                }
+                coordinator.PushAudio(pcm.data(), samples / channels);
+
+                // 스케줄러 대기열이 상한 이하로 줄어든 뒤에 크레딧을 돌려준다 (빠른 생산자는 여기서 멈춘다)
+                if (!WaitForBacklog(coordinator, options.max_pending_chunks, outbox, writer)) {
+                    return false;
+                }
+                credit += size;
+                reply.clear();
+                PutU32(reply, size);
+                if (!writer.Send(FrameType::CREDIT, reply)) {
+                    return false;
+                }
+                break;
+            }
+            case FrameType::ATTACH_SHM: {
+                if (ring || frame.num_fds != 2) {
+                    writer.Error("ATTACH_SHM에는 메모리 fd와 eventfd가 필요합니다");
+                    return false;
+                }
+                ring = std::make_unique<ShmAudioConsumer>();
+                bool attached = ring->Attach(frame.fds[0], frame.fds[1]);
+                frame.num_fds = 0;  // fd 소유권은 ring으로
+                if (!attached || ring->Channels() != channels || ring->SampleRate() != sample_rate) {
+                    writer.Error("공유 메모리 링 형식이 세션과 다릅니다");
+                    return false;
+                }
+                LOG_INFO("ScoringDaemon", "공유 메모리 링 연결 (fd=" + std::to_string(fd) + ")");
+                break;
+            }
+            case FrameType::SNAPSHOT:
+                coordinator.RequestSnapshot();
+                break;
+            case FrameType::FINISH: {
+                if (ring && !DrainRing(*ring, coordinator, options.max_pending_chunks, outbox, writer)) {
+                    return false;
+                }
+                EngineState state = coordinator.FinishStream();
+                if (!outbox.Flush(writer)) {  // 마지막 점수를 RESULT보다 먼저
+                    return false;
+                }
+                if (binary) {
+                    ResultMsgpackWriter result_writer;
+                    const std::string& body = result_writer.Write(state);
+                    writer.Send(FrameType::RESULT, body);
+                } else {
+                    ResultJsonWriter result_writer;
+                    const std::string& body = result_writer.Write(state);
+                    writer.Send(FrameType::RESULT, body);
+                }
+                auto stats = coordinator.GetSchedulingStats();
+                std::stringstream done;
+                done << "세션 완료 (fd=" << fd << ", 청크 " << stats.completed << ", 지연 " << stats.late
+                     << ", 합침 " << stats.coalesced << ", 버림 " << stats.dropped
+                     << ", p99 " << stats.p99_time_to_score * 1000.0 << "ms)";
+                LOG_INFO("ScoringDaemon", done.str());
+                return true;
+            }
+            default:
+                writer.Error("알 수 없는 프레임 타입");
+                return false;
+        }
+    }
+
+    // FINISH 없이 연결이 끊김 - 코디네이터 소멸자가 정리한다
+    LOG_INFO("ScoringDaemon", "세션 연결 끊김 (fd=" + std::to_string(fd) + ")");
+    return false;
+}
+
+} // namespace daemon
+} // namespace realtime_engine_ko
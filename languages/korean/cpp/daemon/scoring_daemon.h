@@ -0,0 +1,64 @@
+// src/cpp/daemon/scoring_daemon.h
+#pragma once
+
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <set>
+
+#include "realtime_engine_ko/w2v_onnx_core.h"
+#include "realtime_engine_ko/inference_scheduler.h"
+#include "realtime_engine_ko/plan_cache.h"
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+struct DaemonOptions {
+    std::string socket_path = "/tmp/realtime_engine_ko.sock";
+    size_t max_sessions = 64;
+    uint32_t initial_credit = 256 * 1024;  // 세션당 처리 대기 가능한 오디오 바이트
+    size_t max_pending_chunks = 2;         // 세션당 스케줄러 대기 청크 상한 (넘으면 크레딧 반환/링 소비를 멈춘다)
+    float confidence_threshold = 0.7f;
+    size_t scheduler_threads = 0;  // 추론 작업자 수 (0이면 하드웨어 스레드 수)
+    float latency_slo = 0.5f;      // 오디오 도착 -> 점수 목표 시간 (초)
+    float drop_after = 0.0f;       // 마감보다 이만큼 늦은 청크는 버림 (0이면 합치기만)
+    size_t plan_cache_bytes = 64u << 20;  // 컴파일된 문장 계획 캐시 상한
+    std::string plan_store_path;          // 비어 있지 않으면 시작 시 적재, 종료 시 저장
+};
+
+// 모델을 한 번만 로드하고 Unix 도메인 소켓으로 여러 세션을 동시에 처리하는 데몬.
+// 연결 하나가 세션 하나이며, 세션마다 공유 코어 위에 EngineCoordinator를 둔다.
+// 흐름 제어: 클라이언트는 크레딧(바이트)만큼만 AUDIO를 보낼 수 있고, 데몬은 세션의 스케줄러 대기 청크가
+// max_pending_chunks 이하로 줄어든 뒤에 CREDIT로 돌려준다. 점수는 세션 스레드가 보낸다.
+class ScoringDaemon {
+public:
+    ScoringDaemon(std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine, const DaemonOptions& options);
+    ~ScoringDaemon();
+
+    bool Start();
+    void Stop();  // 열린 세션을 모두 끊고 종료될 때까지 대기
+    size_t ActiveSessions() const;
+
+private:
+    void AcceptLoop();
+    void HandleConnection(int fd);
+    bool RunSession(int fd);
+
+    std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine;
+    std::shared_ptr<InferenceScheduler> scheduler;
+    DaemonOptions options;
+
+    int listen_fd;
+    std::atomic<bool> is_running;
+    std::unique_ptr<std::thread> accept_thread;
+
+    mutable std::mutex sessions_mutex;
+    std::condition_variable sessions_cv;
+    std::set<int> session_fds;
+};
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -0,0 +1,268 @@
+// src/cpp/daemon/shm_audio_ring.cpp
+#include "shm_audio_ring.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+namespace {
+
+// 샘플 영역은 캐시 라인 경계에서 시작
+constexpr size_t kSamplesOffset = (sizeof(ShmRingHeader) + 63) / 64 * 64;
+
+size_t SegmentSize(uint64_t capacity_frames, uint32_t channels) {
+    return kSamplesOffset + static_cast<size_t>(capacity_frames) * channels * sizeof(float);
+}
+
+uint64_t NextPowerOfTwo(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ShmAudioProducer::ShmAudioProducer()
+    : memory_fd(-1),
+      event_fd(-1),
+      mapped_size(0),
+      header(nullptr),
+      samples(nullptr) {
+}
+
+ShmAudioProducer::~ShmAudioProducer() {
+    Release();
+}
+
+bool ShmAudioProducer::Create(int sample_rate, int channels, size_t capacity_frames) {
+    Release();
+    if (sample_rate <= 0 || channels <= 0 || capacity_frames == 0) {
+        return false;
+    }
+
+    // 이름은 fd를 얻는 데만 쓰고 바로 지운다 (이후 수명은 fd와 매핑이 결정)
+    static std::atomic<uint32_t> counter{0};
+    std::string name = "/realtime_engine_ko-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+    memory_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if (memory_fd < 0) {
+        return false;
+    }
+    shm_unlink(name.c_str());
+
+    uint64_t capacity = NextPowerOfTwo(capacity_frames);
+    mapped_size = SegmentSize(capacity, static_cast<uint32_t>(channels));
+    if (ftruncate(memory_fd, static_cast<off_t>(mapped_size)) < 0) {
+        Release();
+        return false;
+    }
+
+    void* memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    if (memory == MAP_FAILED) {
+        Release();
+        return false;
+    }
+
+    header = new (memory) ShmRingHeader();
+    header->sample_rate = static_cast<uint32_t>(sample_rate);
+    header->channels = static_cast<uint32_t>(channels);
+    header->reserved = 0;
+    header->capacity_frames = capacity;
+    header->write_pos.store(0, std::memory_order_relaxed);
+    header->read_pos.store(0, std::memory_order_relaxed);
+    header->consumer_waiting.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    samples = reinterpret_cast<float*>(static_cast<char*>(memory) + kSamplesOffset);
+
+    event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) {
+        Release();
+        return false;
+    }
+
+    // magic은 마지막에 기록 - 소비자는 완성된 헤더만 본다
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = ShmRingHeader::kMagic;
+    return true;
+}
+
+size_t ShmAudioProducer::Write(const float* interleaved, size_t frames) {
+    if (!header) {
+        return 0;
+    }
+
+    uint64_t capacity = header->capacity_frames;
+    uint64_t write = header->write_pos.load(std::memory_order_relaxed);
+    uint64_t read = header->read_pos.load(std::memory_order_acquire);
+    size_t count = static_cast<size_t>(std::min<uint64_t>(frames, capacity - (write - read)));
+    if (count == 0) {
+        return 0;
+    }
+
+    // 링 끝에서 나뉘면 두 번에 걸쳐 복사
+    size_t channels = header->channels;
+    size_t offset = static_cast<size_t>(write & (capacity - 1));
+    size_t first = std::min(count, static_cast<size_t>(capacity) - offset);
+    std::memcpy(samples + offset * channels, interleaved, first * channels * sizeof(float));
+    if (count > first) {
+        std::memcpy(samples, interleaved + first * channels, (count - first) * channels * sizeof(float));
+    }
+
+    header->write_pos.store(write + count, std::memory_order_release);
+    WakeConsumer();
+    return count;
+}
+
+size_t ShmAudioProducer::WritableFrames() const {
+    if (!header) {
+        return 0;
+    }
+    uint64_t write = header->write_pos.load(std::memory_order_relaxed);
+    uint64_t read = header->read_pos.load(std::memory_order_acquire);
+    return static_cast<size_t>(header->capacity_frames - (write - read));
+}
+
+void ShmAudioProducer::Close() {
+    if (!header) {
+        return;
+    }
+    header->closed.store(1, std::memory_order_release);
+    WakeConsumer();
+}
+
+void ShmAudioProducer::Release() {
+    if (header) {
+        munmap(header, mapped_size);
+        header = nullptr;
+        samples = nullptr;
+    }
+    if (memory_fd >= 0) {
+        close(memory_fd);
+        memory_fd = -1;
+    }
+    if (event_fd >= 0) {
+        close(event_fd);
+        event_fd = -1;
+    }
+    mapped_size = 0;
+}
+
+void ShmAudioProducer::WakeConsumer() {
+    // write_pos 공개와 consumer_waiting 확인 사이의 순서를 보장 (소비자 PrepareWait와 짝)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->consumer_waiting.load(std::memory_order_relaxed) != 0 &&
+        header->consumer_waiting.exchange(0, std::memory_order_acq_rel) != 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(event_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+ShmAudioConsumer::ShmAudioConsumer()
+    : memory_fd(-1),
+      event_fd(-1),
+      mapped_size(0),
+      header(nullptr),
+      samples(nullptr),
+      capacity_frames(0),
+      channels(0),
+      sample_rate(0) {
+}
+
+ShmAudioConsumer::~ShmAudioConsumer() {
+    if (header) {
+        munmap(header, mapped_size);
+    }
+    if (memory_fd >= 0) {
+        close(memory_fd);
+    }
+    if (event_fd >= 0) {
+        close(event_fd);
+    }
+}
+
+bool ShmAudioConsumer::Attach(int memory_fd, int event_fd) {
+    this->memory_fd = memory_fd;
+    this->event_fd = event_fd;
+
+    struct stat info;
+    if (memory_fd < 0 || event_fd < 0 || fstat(memory_fd, &info) < 0 ||
+        static_cast<size_t>(info.st_size) < kSamplesOffset) {
+        return false;
+    }
+
+    mapped_size = static_cast<size_t>(info.st_size);
+    void* memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+    if (memory == MAP_FAILED) {
+        mapped_size = 0;
+        return false;
+    }
+    header = static_cast<ShmRingHeader*>(memory);
+
+    // 다른 프로세스가 만든 헤더이므로 크기를 검증한 값만 사용한다
+    uint64_t capacity = header->capacity_frames;
+    uint32_t header_channels = header->channels;
+    if (header->magic != ShmRingHeader::kMagic || header_channels == 0 || header_channels > 64 ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        capacity > (mapped_size - kSamplesOffset) / (header_channels * sizeof(float))) {
+        return false;
+    }
+
+    capacity_frames = capacity;
+    channels = header_channels;
+    sample_rate = header->sample_rate;
+    samples = reinterpret_cast<const float*>(static_cast<const char*>(memory) + kSamplesOffset);
+    return true;
+}
+
+size_t ShmAudioConsumer::ReadableSpan(const float** data) const {
+    uint64_t read = header->read_pos.load(std::memory_order_relaxed);
+    uint64_t write = header->write_pos.load(std::memory_order_acquire);
+    uint64_t available = std::min<uint64_t>(write - read, capacity_frames);
+
+    size_t offset = static_cast<size_t>(read & (capacity_frames - 1));
+    *data = samples + offset * channels;
+    return static_cast<size_t>(std::min<uint64_t>(available, capacity_frames - offset));
+}
+
+void ShmAudioConsumer::Consume(size_t frames) {
+    uint64_t read = header->read_pos.load(std::memory_order_relaxed);
+    header->read_pos.store(read + frames, std::memory_order_release);
+}
+
+bool ShmAudioConsumer::PrepareWait() {
+    header->consumer_waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // 표시를 세운 뒤 다시 확인해야 생산자의 깨우기를 놓치지 않는다
+    uint64_t read = header->read_pos.load(std::memory_order_relaxed);
+    if (header->write_pos.load(std::memory_order_acquire) != read || IsClosed()) {
+        header->consumer_waiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void ShmAudioConsumer::FinishWait() {
+    header->consumer_waiting.store(0, std::memory_order_relaxed);
+    uint64_t counter;
+    ssize_t ignored = read(event_fd, &counter, sizeof(counter));
+    (void)ignored;
+}
+
+bool ShmAudioConsumer::IsClosed() const {
+    return header->closed.load(std::memory_order_acquire) != 0;
+}
+
+} // namespace daemon
+} // namespace realtime_engine_ko
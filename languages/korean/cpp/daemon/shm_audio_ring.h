@@ -0,0 +1,104 @@
+// src/cpp/daemon/shm_audio_ring.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace realtime_engine_ko {
+namespace daemon {
+
+// 같은 호스트의 캡처 프로세스 -> 엔진으로 PCM을 넘기는 공유 메모리 링 (단일 생산자/단일 소비자).
+// 세그먼트 = [ShmRingHeader][float32 인터리브 샘플 capacity_frames * channels]
+// 위치는 프레임 단위 단조 증가 카운터이고, capacity_frames는 2의 거듭제곱이다.
+// 프레임마다 시스템 콜은 없다: 소비자가 잠들기 전에 consumer_waiting을 세우면
+// 생산자가 다음 쓰기에서 한 번만 eventfd를 깨운다.
+struct ShmRingHeader {
+    static constexpr uint32_t kMagic = 0x524B4F31;  // "RKO1"
+
+    uint32_t magic;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t reserved;
+    uint64_t capacity_frames;
+
+    alignas(64) std::atomic<uint64_t> write_pos;        // 생산자만 기록
+    alignas(64) std::atomic<uint64_t> read_pos;         // 소비자만 기록
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t> closed;                       // 생산자가 더 쓰지 않음
+};
+
+// 프로세스 간 공유이므로 락 프리(주소 독립) 원자 연산이어야 한다
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64비트 원자 연산이 락 프리가 아닙니다");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "32비트 원자 연산이 락 프리가 아닙니다");
+
+// 생산자: 세그먼트와 eventfd를 만들고 샘플을 기록한다 (캡처 서비스에 포함하는 용도)
+class ShmAudioProducer {
+public:
+    ShmAudioProducer();
+    ~ShmAudioProducer();
+
+    ShmAudioProducer(const ShmAudioProducer&) = delete;
+    ShmAudioProducer& operator=(const ShmAudioProducer&) = delete;
+
+    // capacity_frames는 2의 거듭제곱으로 올림된다
+    bool Create(int sample_rate, int channels, size_t capacity_frames = 1 << 16);
+    // 링에 들어간 프레임 수를 반환한다 (가득 차면 일부만 기록, 블로킹하지 않음)
+    size_t Write(const float* interleaved, size_t frames);
+    size_t WritableFrames() const;
+    void Close();  // 소비자에게 입력 끝을 알린다 (세그먼트는 유지)
+    void Release();
+
+    int MemoryFd() const { return memory_fd; }
+    int EventFd() const { return event_fd; }
+
+private:
+    void WakeConsumer();
+
+    int memory_fd;
+    int event_fd;
+    size_t mapped_size;
+    ShmRingHeader* header;
+    float* samples;
+};
+
+// 소비자: 전달받은 fd로 세그먼트를 매핑하고 샘플을 복사 없이 읽는다
+class ShmAudioConsumer {
+public:
+    ShmAudioConsumer();
+    ~ShmAudioConsumer();
+
+    ShmAudioConsumer(const ShmAudioConsumer&) = delete;
+    ShmAudioConsumer& operator=(const ShmAudioConsumer&) = delete;
+
+    // fd 소유권을 가져간다 (실패해도 닫는다)
+    bool Attach(int memory_fd, int event_fd);
+
+    // 읽기 위치부터 연속으로 읽을 수 있는 구간 (링 끝에서 잘림). 0이면 비어 있음
+    size_t ReadableSpan(const float** data) const;
+    void Consume(size_t frames);
+
+    // 잠들기 전 호출: 대기 표시를 세운 뒤에도 비어 있으면 true (EventFd를 poll해도 됨)
+    bool PrepareWait();
+    // 깨어난 뒤 호출: eventfd 카운터와 대기 표시를 정리한다
+    void FinishWait();
+    bool IsClosed() const;
+
+    int SampleRate() const { return static_cast<int>(sample_rate); }
+    int Channels() const { return static_cast<int>(channels); }
+    int EventFd() const { return event_fd; }
+
+private:
+    int memory_fd;
+    int event_fd;
+    size_t mapped_size;
+    ShmRingHeader* header;
+    const float* samples;
+    // 생산자가 헤더를 바꿔도 영향받지 않도록 Attach 시점 값을 보관
+    uint64_t capacity_frames;
+    uint32_t channels;
+    uint32_t sample_rate;
+};
+
+} // namespace daemon
+} // namespace realtime_engine_ko
@@ -35,6 +35,15 @@ PairVI dtw_align(const std::vector<VecD>& X,
         for (int j = 0; j < m; ++j)
             cost[i][j] = euclidean(X[i], Y[j]);
 
+    return dtw_align_cost(cost);
+}
+
+// 로컬 거리 행렬 기반 DTW 정렬
+PairVI dtw_align_cost(const MatD& cost, bool open_end) {
+    int n = cost.size();
+    int m = n > 0 ? cost[0].size() : 0;
+    if (n == 0 || m == 0) return {{}, {}};
+
     const double INF = std::numeric_limits<double>::infinity();
     // 2) 누적 비용 행렬 D와 방향 저장용 dir 행렬
     MatD D(n+1, VecD(m+1, INF));
@@ -70,13 +79,21 @@ PairVI dtw_align(const std::vector<VecD>& X,
         }
     }
 
-    // 4) 역추적: (n,m) → (0,0)
+    // 4) 역추적: (n,m) → (0,0), open_end면 (n, argmin_j D[n][j])에서 시작
+    int end_j = m;
+    if (open_end) {
+        for (int jj = 1; jj <= m; ++jj) {
+            if (D[n][jj] < D[n][end_j]) end_j = jj;
+        }
+    }
+
     std::vector<int> idx1, idx2;
-    int i = n, j = m;
+    int i = n, j = end_j;
     while (i > 0 && j > 0) {
         idx1.push_back(i-1);
         idx2.push_back(j-1);
         int p = dir[i][j];
+        if (p < 0) break;  // 도달 불가능한 셀
         const auto& pat = pattern[p];
         // base offset로 이동
         i += (int)pat[0][0];
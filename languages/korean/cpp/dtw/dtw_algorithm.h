@@ -19,5 +19,10 @@ double euclidean(const VecD& a, const VecD& b);
 PairVI dtw_align(const std::vector<VecD>& X,
                  const std::vector<VecD>& Y);
 
+// 미리 계산된 로컬 거리 행렬(cost[n][m])로 DTW 정렬
+// open_end=true면 Y의 끝을 고정하지 않고 X 전체에 대해 누적 비용이 최소인 Y 위치에서 끝낸다
+// (AsymmetricP1은 X 길이로 정규화되므로 끝 위치 간 비교가 가능)
+PairVI dtw_align_cost(const MatD& cost, bool open_end = false);
+
 } // namespace dtw
 } // namespace realtime_engine_ko
\ No newline at end of file
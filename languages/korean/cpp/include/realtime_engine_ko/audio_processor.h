@@ -12,6 +12,9 @@
 #include <map>
 #include <Eigen/Dense>
 #include <sndfile.h>
+#include "voice_activity_detector.h"
+#include "resampler.h"
+#include "stage_metrics.h"
 
 namespace realtime_engine_ko {
 
@@ -26,18 +29,54 @@ public:
     bool SetAudioFile(const std::string& file_path);
     bool StartMonitoring();
     void StopMonitoring();
+    // 모니터링 한 번: 파일이 늘었으면 새 오디오를 읽어 청크를 처리한다.
+    // StartMonitoring 대신 외부 이벤트 루프(Reactor)에서 호출할 수 있다 (동시 호출 금지)
+    void PollFile();
+    float GetPollingInterval() const { return polling_interval; }
+    int GetSampleRate() const { return sample_rate; }
+    // PollFile/모니터링 스레드의 단계 시간을 기록할 세션 지표 (nullptr이면 프로세스 전체 지표만)
+    void SetStageMetrics(StageMetrics* metrics) { stage_metrics = metrics; }
     std::pair<AudioTensor, std::map<std::string, std::any>> GetLatestChunk() const;
     void Reset();
     void AddChunkCallback(CallbackFunc callback);
     
+    // 오프라인: 파일 전체를 읽어 청크 콜백을 호출 스레드에서 동기 실행 (chunked=false면 단일 청크)
+    bool ProcessFile(const std::string& file_path, bool chunked = true);
+    // 버퍼에 남은 오디오를 청크로 내보낸다
+    void Flush();
+    
+    // 스트리밍 입력: 파일 대신 인터리브 PCM을 직접 받는다 (sample_rate 모노로 변환).
+    // 청크 콜백은 PushAudio를 호출한 스레드에서 실행된다.
+    void StartStream(int input_sample_rate, int channels);
+    void PushAudio(const float* interleaved, size_t frames);
+    
+    // 오프라인 장문: 파일 전체를 sample_rate 모노로 읽는다 (청크 콜백 없음)
+    bool LoadFile(const std::string& file_path, AudioTensor& audio);
+    // min_pause 이상 이어지는 무음의 가운데에서 자르고, max_segment를 넘으면 최소 에너지 지점에서 자른다.
+    // 무음뿐인 세그먼트는 제외하며, 각 세그먼트는 정규화되어 반환된다. (단위: 초)
+    std::vector<AudioTensor> SplitAtPauses(const AudioTensor& audio, float min_pause = 0.3f,
+                                           float min_segment = 1.0f, float max_segment = 12.0f) const;
+    
+    // 무음 구간 기반 청크 분할 설정 (단위: 초)
+    // target(chunk_duration) ± tolerance 범위에서 에너지가 가장 낮은 지점에서 자른다.
+    void SetAdaptiveChunking(bool enabled, float tolerance = 0.5f,
+                             float min_duration = 1.0f, float max_duration = 3.0f);
+    
+    // 청크 통계 (VAD로 건너뛴 무음 청크 포함)
+    int GetTotalChunks() const { return total_chunks; }
+    int GetSilentChunks() const { return silent_chunks; }
+    
 private:
     void MonitoringLoop();
     void ProcessNewAudioData();
-    void AddToBuffer(const std::vector<float>& audio_data);
-    void CheckAndProcessChunks();
+    bool ReadNewAudioData(std::vector<float>& mono_frames);
+    void AddToBuffer(const std::vector<float>& audio_data, bool process_chunks = true);
+    void CheckAndProcessChunks(bool flush = false);
+    void EmitChunk(const AudioTensor& chunk);
+    int FindChunkLength(bool flush) const;
     AudioTensor ExtractChunk(int chunk_samples);
-    AudioTensor PreprocessChunk(const std::vector<float>& chunk, bool do_normalize = true);
-    bool DetectVoiceActivity(const std::vector<float>& audio_data, float energy_threshold = 0.0005, int min_speech_frames = 10);
+    AudioTensor PreprocessChunk(const AudioTensor& chunk, bool do_normalize = true);
+    static AudioTensor NormalizeChunk(const AudioTensor& chunk);
     
     int sample_rate;
     float chunk_duration;
@@ -48,14 +87,30 @@ private:
     sf_count_t last_processed_pos;
     std::atomic<bool> is_monitoring;
     std::unique_ptr<std::thread> monitoring_thread;
+    StageMetrics* stage_metrics = nullptr;
+    
+    std::unique_ptr<PolyphaseResampler> resampler;  // 입력 레이트/채널 → sample_rate 모노
+    std::vector<float> read_buffer;  // 파일 읽기용 재사용 버퍼 (인터리브)
+    std::vector<float> stream_buffer;  // 스트리밍 입력 리샘플링 결과 재사용 버퍼
     
-    std::vector<std::vector<float>> buffer;
+    std::vector<float> buffer;  // 아직 청크로 잘리지 않은 모노 샘플 (연속 메모리)
     std::chrono::system_clock::time_point last_chunk_time;
     float total_duration;
+    double emitted_duration;  // 청크로 내보낸 오디오 길이 (VAD로 건너뛴 무음 청크 포함, 초)
     AudioTensor latest_chunk;
     
+    VoiceActivityDetector vad;
+    std::atomic<int> total_chunks;
+    std::atomic<int> silent_chunks;
+    
+    // 적응형 청크 분할
+    bool adaptive_chunking;
+    float chunk_tolerance;
+    float min_chunk_duration;
+    float max_chunk_duration;
+    
     std::vector<CallbackFunc> chunk_callbacks;
-    std::mutex buffer_mutex;
+    mutable std::mutex buffer_mutex;
 };
 
 } // namespace realtime_engine_ko
\ No newline at end of file
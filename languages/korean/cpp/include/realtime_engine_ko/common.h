@@ -2,6 +2,7 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 #include <vector>
 #include <map>
 #include <any>
@@ -18,7 +19,7 @@ using AudioTensor = Eigen::Matrix<float, Eigen::Dynamic, 1>;
 using MetadataMap = std::map<std::string, std::any>;
 using ResultMap = std::map<std::string, std::any>;
 
-// 로깅 유틸리티 (간단한 구현)
+// 로깅 유틸리티
 enum class LogLevel {
     DEBUG,
     INFO,
@@ -26,12 +27,41 @@ enum class LogLevel {
     ERROR
 };
 
-void Logger(LogLevel level, const std::string& component, const std::string& message);
+// 이 값보다 낮은 레벨의 LOG_* 호출은 컴파일 시 제거된다 (0=DEBUG ... 3=ERROR, CMake 캐시 변수로 지정)
+#ifndef REALTIME_ENGINE_KO_MIN_LOG_LEVEL
+#define REALTIME_ENGINE_KO_MIN_LOG_LEVEL 0
+#endif
 
-// 간단한 로깅 매크로
-#define LOG_DEBUG(component, message) realtime_engine_ko::Logger(realtime_engine_ko::LogLevel::DEBUG, component, message)
-#define LOG_INFO(component, message) realtime_engine_ko::Logger(realtime_engine_ko::LogLevel::INFO, component, message)
-#define LOG_WARNING(component, message) realtime_engine_ko::Logger(realtime_engine_ko::LogLevel::WARNING, component, message)
-#define LOG_ERROR(component, message) realtime_engine_ko::Logger(realtime_engine_ko::LogLevel::ERROR, component, message)
+namespace detail {
+extern std::atomic<int> log_threshold;
+} // namespace detail
+
+// 실행 중 레벨 하한 (기본 INFO). 메시지를 만들기 전에 LogEnabled로 확인한다
+void SetLogLevel(LogLevel level);
+LogLevel GetLogLevel();
+
+inline bool LogEnabled(LogLevel level) {
+    return static_cast<int>(level) >= REALTIME_ENGINE_KO_MIN_LOG_LEVEL &&
+           static_cast<int>(level) >= detail::log_threshold.load(std::memory_order_relaxed);
+}
+
+// 메시지를 잠금 없는 큐에 넣고 바로 반환한다 (포맷/출력/flush는 백그라운드 스레드).
+// 큐가 가득 차면 기다리지 않고 버리며, 버린 수는 다음 출력 때 함께 기록된다
+void Logger(LogLevel level, const std::string& component, std::string message);
+// 지금까지 넣은 메시지가 모두 출력될 때까지 기다린다 (종료 직전/오류 보고용, 추론 스레드에서 호출 금지)
+void FlushLogs();
+
+// 로깅 매크로: 레벨이 꺼져 있으면 message 식을 평가하지 않는다
+#define REALTIME_ENGINE_KO_LOG(level, component, message) \
+    do { \
+        if (realtime_engine_ko::LogEnabled(level)) { \
+            realtime_engine_ko::Logger(level, component, message); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(component, message) REALTIME_ENGINE_KO_LOG(realtime_engine_ko::LogLevel::DEBUG, component, message)
+#define LOG_INFO(component, message) REALTIME_ENGINE_KO_LOG(realtime_engine_ko::LogLevel::INFO, component, message)
+#define LOG_WARNING(component, message) REALTIME_ENGINE_KO_LOG(realtime_engine_ko::LogLevel::WARNING, component, message)
+#define LOG_ERROR(component, message) REALTIME_ENGINE_KO_LOG(realtime_engine_ko::LogLevel::ERROR, component, message)
 
 } // namespace realtime_engine_ko
\ No newline at end of file
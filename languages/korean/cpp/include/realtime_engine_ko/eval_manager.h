@@ -5,43 +5,100 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <functional>
 #include <chrono>
+#include <optional>
 #include <Eigen/Dense>
 #include "sentence_block.h"
 #include "progress_tracker.h"
 #include "w2v_onnx_core.h"
+#include "sentence_plan.h"
+#include "incremental_aligner.h"
+#include "frame_store.h"
+#include "result_types.h"
 
 namespace realtime_engine_ko {
 
 class EvaluationController {
 public:
+    using SpillSink = std::function<void(const BlockResult&)>;
+    
+    // 키워드 검출 점수(토큰당 평균 최대 로그 확률)가 최고 후보보다 이만큼 이상 낮은 블록은 정렬하지 않는다.
+    // 음수면 윈도우 내 모든 블록을 정렬한다. 채점 대상 블록이 바뀌므로 기본은 끄고 호출자가 선택한다
+    static constexpr float kDefaultCandidateMargin = -1.0f;
+    
     EvaluationController(
         std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
         std::shared_ptr<SentenceBlockManager> sentence_manager,
         std::shared_ptr<ProgressTracker> progress_tracker,
+        std::shared_ptr<const SentencePlan> plan,
         float confidence_threshold = 10.0f,
-        float min_time_between_evals = 0.1f);
+        float min_time_between_evals = 0.1f,
+        float candidate_margin = kDefaultCandidateMargin);
+
     
-    std::map<std::string, std::any> ProcessRecognitionResult(
+    EvaluationResult ProcessRecognitionResult(
         const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_chunk,
         const std::map<std::string, std::any>& metadata);
     
-    std::map<std::string, std::any> GetEvaluationSummary() const;
+    // 장문 오프라인: 인코더 출력이 준비된 세그먼트를 순서대로 병합한다.
+    // 활성 블록(frontier)부터 정렬해 소비된 블록을 평가하고 frontier를 전진시킨다. 반환 값은 소비된 블록 수.
+    int MergeSegmentAlignment(
+        const Wav2VecCTCOnnxCore::EncoderOutput& output,
+        float segment_duration,
+        float remaining_duration);
+    
+    // 실시간 매칭을 윈도우 블록 재채점 대신 문장 전체 증분 정렬로 한다 (Initialize 직후 호출)
+    void EnableIncrementalAlignment(const IncrementalAligner::Options& options = IncrementalAligner::Options());
+    // 오디오 끝: 증분 정렬의 남은 블록을 확정한다. 새로 평가된 블록이 있으면 true
+    bool FinishAlignment();
+    
+    // 처리한 청크의 사후 확률(과 선택적으로 히든 상태)을 세션 시간축에 보관한다 (Initialize 직후 호출)
+    void EnableFrameStore(const FrameStore::Options& options);
+    // 보관된 [begin_seconds, end_seconds) 구간을 블록에 다시 채점한다 (인코더 재실행 없음).
+    // 프레임 저장소가 없거나 구간이 이미 버려졌으면 nullopt. 평가 상태는 바꾸지 않는다
+    std::optional<GopResult> RescoreBlock(int block_id, double begin_seconds, double end_seconds) const;
+    std::optional<FrameStore::Stats> GetFrameStoreStats() const;
+    
+    // 장문 모드: 활성 블록보다 resident_blocks 이상 뒤처진 블록은 최종 결과를 sink로 내보내고 캐시와 함께 내린다.
+    // 점수/완료 수는 누적 집계로, 단어 목록과 요약의 블록 목록은 상주 블록만으로 만든다 (청크당 비용이 문장 길이와 무관)
+    void EnableResidency(size_t resident_blocks, SpillSink sink);
+    
+    EvaluationSummary GetEvaluationSummary() const;
+    EvaluationResult GetResult() const;
     void Reset();
     
 private:
-    std::map<std::string, std::any> CreateResultFormat() const;
-    void EvaluateBlock(int block_id, const std::map<std::string, std::any>& evaluation_data);
+    // 블록별 최근 GOP 계산 결과
+    struct CachedEvaluation {
+        float gop_score = 0.0f;
+        float coverage = 1.0f;
+        GopResult details;
+        std::time_t timestamp = 0;
+    };
+    
+    EvaluationResult ProcessIncremental(const Wav2VecCTCOnnxCore::EncoderOutput& output);
+    void ApplyAlignedBlocks(const std::vector<IncrementalAligner::BlockScore>& blocks);
+    EvaluationResult CreateResultFormat() const;
+    EvaluationResult CreateLongFormResult() const;
+    void SpillBlocks();
+    void EvaluateBlock(int block_id, const CachedEvaluation& evaluation);
     
     std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine;
     std::shared_ptr<SentenceBlockManager> sentence_manager;
     std::shared_ptr<ProgressTracker> progress_tracker;
+    std::shared_ptr<const SentencePlan> plan;  // Initialize에서 컴파일된 블록별 토큰
     float confidence_threshold;
     float min_time_between_evals;
+    float candidate_margin;
     
     std::optional<std::chrono::system_clock::time_point> last_eval_time;
-    std::map<int, std::map<std::string, std::any>> pending_evaluations;
-    std::map<int, std::map<std::string, std::any>> cached_results;
+    std::map<int, CachedEvaluation> pending_evaluations;
+    std::map<int, CachedEvaluation> cached_results;
+    int segment_frontier = 0;  // 장문 병합에서 아직 소비되지 않은 첫 블록
+    std::unique_ptr<IncrementalAligner> aligner;  // 증분 정렬 모드에서만 존재
+    std::unique_ptr<FrameStore> frame_store;      // 재채점용 프레임 보관 (꺼져 있으면 nullptr)
+    SpillSink spill_sink;                         // 장문 모드에서 내려진 블록 결과
 };
 
 } // namespace realtime_engine_ko
\ No newline at end of file
@@ -0,0 +1,75 @@
+// frame_store.h
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "w2v_onnx_core.h"
+
+namespace realtime_engine_ko {
+
+// 세션이 처리한 청크의 인코더 출력을 보관해, 지난 구간을 ONNX 재추론 없이 다시 채점할 수 있게 한다.
+// 사후 확률은 프레임마다 -log p를 8비트로 양자화해 저장하고 (분해능 약 0.06 nat, p < e^-16은 0으로 취급),
+// 히든 상태는 store_hidden일 때만 float로 저장한다. 히든이 없으면 재채점 정렬은 사후 확률 비용으로 한다.
+// 메모리 상한을 넘으면 가장 오래된 청크부터 버린다. 기본 상한은 0(끔)이라 재채점하는 클라이언트만
+// EngineCoordinator::SetFrameStoreOptions로 켠다 (세션마다 16MB면 청크당 양자화·복사 비용도 무시할 수 없다).
+// 모든 메서드는 스레드 안전하다.
+class FrameStore {
+public:
+    struct Options {
+        size_t max_bytes = 0;  // 0이면 아무것도 저장하지 않는다 (재채점에는 예: 16u << 20)
+        bool store_hidden = false;
+    };
+
+    struct Stats {
+        size_t chunks = 0;
+        size_t frames = 0;
+        size_t bytes = 0;
+        size_t evicted_frames = 0;
+        double begin_time = 0.0;  // 보관 중인 가장 이른 시각 (초)
+        double end_time = 0.0;    // 지금까지 추가된 오디오 끝 시각 (초)
+    };
+
+    FrameStore();
+    explicit FrameStore(const Options& options);
+
+    // audio_seconds 길이 오디오의 인코더 출력을 세션 시간축 끝에 이어 붙인다
+    void Append(const Wav2VecCTCOnnxCore::EncoderOutput& output, double audio_seconds);
+    // 프레임 없이 시간축 끝을 seconds까지 옮긴다 (무음으로 건너뛰었거나 버린 청크, 이미 지났으면 무시)
+    void SkipTo(double seconds);
+
+    // 시간 [begin_seconds, end_seconds)에 중심이 들어가는 프레임을 복원한다.
+    // 구간 일부가 이미 버려졌거나 프레임이 없으면 false
+    bool Read(double begin_seconds, double end_seconds, Wav2VecCTCOnnxCore::EncoderOutput& output) const;
+
+    Stats GetStats() const;
+    void Clear();
+
+private:
+    struct Chunk {
+        double start_time = 0.0;
+        double duration = 0.0;
+        int frames = 0;
+        int vocab = 0;
+        std::vector<uint8_t> log_probs;  // 프레임 우선, 프레임 × 어휘
+        Eigen::MatrixXf hidden;          // store_hidden일 때만
+        size_t bytes = 0;
+    };
+
+    static uint8_t Quantize(float prob);
+
+    mutable std::mutex mutex;
+    Options options;
+    std::deque<Chunk> chunks;
+    size_t total_bytes = 0;
+    size_t total_frames = 0;
+    size_t evicted_frames = 0;
+    double evicted_until = 0.0;  // 이 시각 이전은 버려졌다
+    double end_time = 0.0;
+};
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,123 @@
+// incremental_aligner.h
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "w2v_onnx_core.h"
+#include "sentence_plan.h"
+#include "result_types.h"
+
+namespace realtime_engine_ko {
+
+// 지금까지의 모든 오디오를 문장 전체 토큰 열에 하나의 DTW로 정렬하며, 청크마다 새 프레임 행만 이어 계산한다.
+// 템플릿은 토큰마다 frames_per_token 행을 반복한 것이고, AsymmetricP1 단계로 템플릿의 2배 속도까지 따라간다.
+// 더 느린 발화나 쉼은 한 열에 머무는 hold 단계가 흡수한다. hold의 로컬 비용은 토큰 거리와 CTC blank('|')
+// 거리 중 작은 값이라 쉼이 엉뚱한 토큰으로 끌려가지 않고, 열 0(첫 토큰 앞)에 머물며 앞쪽 무음을 건너뛸 수 있다.
+// hold 프레임은 점수에서 뺀다.
+// 열린 끝(open-end) 최소 비용 열이 frontier다. frontier가 블록 마지막 토큰을 finalize_margin_tokens 이상 지나면
+// 그 블록을 역추적해 한 번만 채점하고 확정하며, 이후 행은 확정되지 않은 첫 블록부터만 계산한다.
+// 행마다 직전 행의 최선 열 ± band_tokens 토큰 범위의 열만 계산하고 그 토큰의 거리만 구하므로
+// 프레임당 비용은 문장 길이와 무관하다. 블록을 확정하면 최선 경로에서 남은 컨텍스트 블록이 시작되는
+// 프레임을 알 수 있으므로, 그보다 trim_margin_frames 이상 앞선 프레임 행은 버린다. 행마다 자기 열 범위의
+// 토큰 확률만 두므로 메모리와 역추적 길이는 발화 전체가 아니라 아직 확정되지 않은 구간에 비례한다.
+// 세션 하나가 순서대로 호출하며 스레드 안전하지 않다.
+class IncrementalAligner {
+public:
+    struct Options {
+        int frames_per_token = 12;       // 50 프레임/초 기준 토큰(음절)당 약 0.24초
+        int finalize_margin_tokens = 2;  // 다음 블록의 구분자와 첫 토큰까지 지나야 확정
+        int trim_margin_frames = 25;     // 정렬 경계 앞에 남겨 두는 프레임 (약 0.5초)
+        int band_tokens = 8;             // 직전 최선 열 앞뒤로 계산하는 토큰 수 (프레임당 비용 상한)
+    };
+
+    struct BlockScore {
+        int block_id = -1;
+        float coverage = 0.0f;  // 프레임이 정렬된 토큰 비율
+        GopResult result;       // 블록 단어 점수 (ScoreBlock과 같은 반올림 규칙)
+    };
+
+    IncrementalAligner(std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+                       std::shared_ptr<const SentencePlan> plan);
+    IncrementalAligner(std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+                       std::shared_ptr<const SentencePlan> plan,
+                       const Options& options);
+
+    // 청크의 인코더 출력을 정렬에 이어 붙이고 새로 확정된 블록을 순서대로 반환
+    std::vector<BlockScore> Extend(const Wav2VecCTCOnnxCore::EncoderOutput& output, float eps = 1e-8f);
+    // 오디오 끝: 남은 블록을 현재 최선 경로로 확정 (정렬된 토큰이 없는 블록은 제외).
+    // 정렬 경로가 없으면 남은 블록을 모두 정렬되지 않은 것(coverage 0)으로 확정한다
+    std::vector<BlockScore> Finish(float eps = 1e-8f);
+
+    int NextBlock() const { return next_block; }      // 확정되지 않은 첫 블록
+    int FrontierToken() const { return frontier_token; }
+    size_t Frames() const { return num_frames; }
+    size_t RetainedFrames() const { return dir_rows.size(); }  // 버리지 않고 남은 행 수
+    void Reset();
+
+private:
+    // 한 행의 누적 비용 (first_column부터 계산한 열만 두고, 나머지 열은 도달 불가)
+    struct CostRow {
+        int first_column = 0;
+        std::vector<double> cost;
+
+        double At(int column) const;
+        int LastColumn() const { return first_column + static_cast<int>(cost.size()) - 1; }
+    };
+
+    // 한 프레임의 토큰 거리 (토큰 first_token부터 num_tokens개, 범위 밖 토큰은 도달 불가)
+    struct DistanceRow {
+        const float* data = nullptr;
+        int first_token = 0;
+        int num_tokens = 0;
+    };
+
+    struct DirRow {
+        int first_column = 1;      // dir[0]에 해당하는 템플릿 열 (1부터)
+        std::vector<int8_t> dir;   // 선택된 단계 패턴 (-1이면 도달 불가)
+        int first_token = 0;       // probs[0]에 해당하는 문장 토큰
+        std::vector<float> probs;  // 이 행의 열 범위에 걸친 토큰들의 사후 확률
+    };
+
+    // current는 이 프레임, previous는 직전 프레임의 토큰 거리 (패턴 2가 참조), pause_cost는 이 프레임의 blank 거리
+    void AppendFrame(const DistanceRow& current, const DistanceRow& previous, double pause_cost);
+    // 열 j(1부터)의 로컬 비용 = 토큰 (j-1)/frames_per_token까지의 거리 (범위 밖이면 inf)
+    double LocalCost(const DistanceRow& distances, int column) const;
+    int BestEndColumn() const;
+    // (num_frames, end_column)에서 역추적해 first_token 이상 토큰의 프레임 수를 세고 원시 점수를 채운다.
+    // token_first_frame에는 토큰마다 처음 정렬된 프레임(0부터, 없으면 -1)을 채운다. 버린 행에서 멈춘다
+    void Backtrack(int end_column, int first_token, std::vector<int>& token_frames,
+                   std::vector<int>& token_first_frame, std::vector<float>& raw_scores, float eps) const;
+    // frame 이전 행을 버린다
+    void TrimRowsBefore(size_t frame);
+    // at_end면 정렬된 토큰이 없는 블록은 결과에서 뺀다
+    std::vector<BlockScore> FinalizeBlocks(int last_block, int end_column, bool at_end, float eps);
+
+    std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine;
+    std::shared_ptr<const SentencePlan> plan;
+    Options options;
+
+    int num_tokens;
+    int num_columns;   // num_tokens * frames_per_token
+    int separator_id;  // CTC blank ('|'), 쉼의 비용 기준
+
+    // DP 상태: 직전 두 행의 누적 비용과 직전 행의 토큰 거리 (모두 band 폭, 버퍼는 재사용)
+    CostRow cost_prev;   // D[i-1][*]
+    CostRow cost_prev2;  // D[i-2][*]
+    CostRow cost_current;
+    std::vector<float> distance_prev;  // 이전 청크 마지막 프레임의 토큰 거리
+    int distance_prev_first_token = 0;
+    int best_column = 0;               // 마지막 행에서 누적 비용이 최소인 열 (band 중심, 0이면 아직 앞쪽 무음)
+    std::deque<DirRow> dir_rows;     // 버리지 않은 프레임 행마다 하나 (역추적용)
+    size_t trimmed_frames = 0;       // dir_rows.front()의 프레임 번호 (0부터)
+    size_t num_frames = 0;
+
+    int first_column = 1;  // 확정되지 않은 첫 블록의 시작 열
+    int next_block = 0;
+    int frontier_token = -1;
+};
+
+} // namespace realtime_engine_ko
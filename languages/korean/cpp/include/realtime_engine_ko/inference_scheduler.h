@@ -0,0 +1,117 @@
+// inference_scheduler.h
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+#include "common.h"
+
+namespace realtime_engine_ko {
+
+// 여러 세션의 청크 추론 작업을 공유 작업자 풀에서 마감 시각 우선(EDF)으로 처리한다.
+// 마감 시각 = 오디오 도착 시각 + 세션 지연 목표(SLO).
+// 세션 안의 청크는 도착 순서대로 하나씩만 실행되고(평가 상태가 순차적이므로),
+// 세션 사이에서는 가장 급한 세션의 앞 청크가 먼저 실행된다.
+// 이미 늦은 청크는 뒤에 쌓인 청크와 합쳐 한 번에 추론하고, drop_after_seconds보다 늦으면 버린다.
+class InferenceScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using SessionId = uint64_t;
+    using ChunkHandler = std::function<void(const AudioTensor&, const MetadataMap&)>;
+
+    struct Options {
+        size_t num_threads = 0;             // 0이면 하드웨어 스레드 수
+        float max_coalesce_seconds = 6.0f;  // 늦은 청크를 합칠 때 최대 오디오 길이
+        float drop_after_seconds = 0.0f;    // 마감보다 이만큼 늦으면 버림 (0이면 버리지 않음)
+        int sample_rate = 16000;
+    };
+
+    // 세션별 지연 통계 (초 단위)
+    struct SessionStats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;   // 실행된 작업 수 (합쳐진 청크는 하나로 센다)
+        uint64_t late = 0;        // 마감 이후 완료된 작업 수
+        uint64_t coalesced = 0;   // 앞 작업에 합쳐진 청크 수
+        uint64_t dropped = 0;
+        double mean_time_to_score = 0.0;  // 도착 -> 점수 계산 완료
+        double p99_time_to_score = 0.0;   // 최근 kRecentSamples개 기준
+        double max_lateness = 0.0;
+    };
+
+    static constexpr size_t kRecentSamples = 1024;
+
+    InferenceScheduler();
+    explicit InferenceScheduler(const Options& options);
+    ~InferenceScheduler();
+
+    InferenceScheduler(const InferenceScheduler&) = delete;
+    InferenceScheduler& operator=(const InferenceScheduler&) = delete;
+
+    SessionId RegisterSession(float latency_slo, ChunkHandler handler);
+    void UnregisterSession(SessionId id);  // 대기 작업은 버리고 실행 중인 작업이 끝날 때까지 대기
+
+    void Submit(SessionId id, const AudioTensor& chunk, const MetadataMap& metadata,
+                Clock::time_point arrival = Clock::now());
+    void Drain(SessionId id);   // 세션의 대기 작업이 모두 처리될 때까지 대기
+    void Cancel(SessionId id);  // 대기 작업을 버리고 실행 중인 작업이 끝날 때까지 대기
+    // 세션의 대기 작업이 max_pending개 이하가 될 때까지 최대 timeout 동안 대기 (입력 흐름 제어용).
+    // 이하가 되었거나 세션이 없으면 true
+    bool WaitForBacklog(SessionId id, size_t max_pending, Clock::duration timeout);
+
+    SessionStats GetSessionStats(SessionId id) const;
+    size_t Size() const { return workers.size(); }
+
+private:
+    struct Job {
+        AudioTensor audio;
+        MetadataMap metadata;
+        Clock::time_point arrival;
+        Clock::time_point deadline;
+    };
+
+    struct Session {
+        Clock::duration latency_slo;
+        ChunkHandler handler;
+        std::deque<Job> pending;
+        bool running = false;
+        bool queued = false;  // ready 힙에 항목이 있음
+        bool removed = false;
+        SessionStats stats;
+        double total_time_to_score = 0.0;
+        std::vector<double> recent;  // 최근 도착 -> 완료 시간 (링)
+        size_t recent_next = 0;
+    };
+
+    struct ReadyEntry {
+        Clock::time_point deadline;
+        SessionId id;
+        bool operator>(const ReadyEntry& other) const { return deadline > other.deadline; }
+    };
+
+    void WorkerLoop();
+    void MakeReady(SessionId id, Session& session);  // mutex 보유 상태에서 호출
+    void Coalesce(Session& session, Job& job);
+    void RecordCompletion(Session& session, const Job& job, Clock::time_point finished);
+
+    Options options;
+    std::vector<std::thread> workers;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> ready;
+    std::unordered_map<SessionId, std::shared_ptr<Session>> sessions;
+    SessionId next_session_id;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    bool stopping;
+};
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,84 @@
+// plan_cache.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "sentence_plan.h"
+
+namespace realtime_engine_ko {
+
+class Wav2VecCTCOnnxCore;
+
+// 컴파일된 문장 계획의 프로세스 공용 LRU 캐시 (키: 모델 버전 + 문장 텍스트).
+// 계획은 불변이므로 여러 세션이 같은 shared_ptr을 동시에 읽는다. 모든 메서드는 스레드 안전하다.
+//
+// 디스크 저장소 형식 (little-endian, 읽을 때는 mmap):
+//   [magic "RKPC"][u32 format][u32 model_version 길이][model_version][u32 entry 수]
+//   entry: [u32 문장 길이][문장][u32 블록 수]
+//          블록마다 [u32 텍스트 길이][텍스트][i32 target_word_index][i32 target_word_count]
+//                   [u32 n][n × i32 컨텍스트 토큰][u32 m][m × i32 대상 토큰]
+class PlanCache {
+public:
+    struct Options {
+        size_t max_bytes = 64u << 20;  // SentencePlan::MemoryBytes() 합계 상한
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    PlanCache();
+    explicit PlanCache(const Options& options);
+
+    // 프로세스 공용 인스턴스 (EngineCoordinator 기본값)
+    static std::shared_ptr<PlanCache> Global();
+
+    void SetMaxBytes(size_t max_bytes);
+
+    // 캐시에 있으면 바로 반환하고, 없으면 컴파일해 넣는다
+    std::shared_ptr<const SentencePlan> GetOrCompile(Wav2VecCTCOnnxCore& engine, const std::string& sentence);
+
+    // 디스크 저장소를 mmap으로 읽어 캐시에 미리 채운다. 모델 버전이 다르면 건너뛴다. 반환 값은 적재된 계획 수
+    size_t Preload(Wav2VecCTCOnnxCore& engine, const std::string& path);
+    // 해당 모델 버전의 캐시 항목을 오래된 것부터 저장 (임시 파일에 쓴 뒤 rename). 반환 값은 저장된 계획 수
+    size_t Save(const Wav2VecCTCOnnxCore& engine, const std::string& path) const;
+
+    Stats GetStats() const;
+    void Clear();
+
+private:
+    struct Entry {
+        std::string key;
+        std::string model_version;
+        std::string sentence;
+        std::shared_ptr<const SentencePlan> plan;
+        size_t bytes = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    static std::string MakeKey(const std::string& model_version, const std::string& sentence);
+    // 호출자가 mutex를 잡고 있어야 한다
+    void InsertLocked(Entry entry);
+    void EvictLocked();
+
+    mutable std::mutex mutex;
+    Options options;
+    EntryList lru;  // 앞쪽이 최근 사용
+    std::unordered_map<std::string, EntryList::iterator> index;
+    size_t total_bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+} // namespace realtime_engine_ko
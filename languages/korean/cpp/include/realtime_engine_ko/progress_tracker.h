@@ -23,11 +23,29 @@ public:
     void Reset();
     void AdjustTimeParameters(double avg_time_per_block, double min_time_for_advance);
     
+    // 블록별 음절 수 (음절당 발화 속도 추정용). 비어 있으면 블록 단위 추정만 사용
+    void SetBlockSyllables(const std::vector<int>& syllables);
+    // 평가 이벤트로 발화 속도를 갱신하고 윈도우 크기를 조정한다.
+    // on_track: 평가된 블록이 현재 인덱스(기대 블록)였는지
+    void ObserveEvaluation(int block_id, bool on_track);
+    // 청크에서 확신할 수 있는 매치를 찾지 못함 -> 윈도우를 한 블록 넓힌다
+    void ObserveMiss();
+    
+    int GetWindowSize() const { return adaptive_window; }
+    double GetSecondsPerBlock() const { return avg_time_per_block; }
+    double GetSecondsPerSyllable() const { return seconds_per_syllable; }
+    
 private:
+    static constexpr double kRateSmoothing = 0.3;   // 지수 평균 가중치 (새 관측 비율)
+    static constexpr int kOnTrackStreakToShrink = 2;  // 연속으로 기대 블록이 맞으면 윈도우를 1로
+    
     int total_blocks;
-    int window_size;
+    int window_size;  // 최대 윈도우 크기
     bool time_based_advance;
     
+    int adaptive_window;
+    int on_track_streak = 0;
+    
     int current_index;
     std::optional<std::chrono::system_clock::time_point> start_time;
     std::optional<std::chrono::system_clock::time_point> last_advance_time;
@@ -37,6 +55,11 @@ private:
     
     // 블록 자동 진행 최소 시간 (초)
     double min_time_for_advance = 1.5;
+    
+    // 음절당 평균 소요 시간 (초, 0이면 아직 관측 없음)
+    double seconds_per_syllable = 0.0;
+    std::vector<int> cumulative_syllables;  // [i] = 블록 0..i-1의 음절 수 합
+    std::optional<std::chrono::system_clock::time_point> last_observation_time;
 };
 
 } // namespace realtime_engine_ko
\ No newline at end of file
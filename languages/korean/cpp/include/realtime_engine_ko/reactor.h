@@ -0,0 +1,84 @@
+// reactor.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "thread_pool.h"
+
+namespace realtime_engine_ko {
+
+// 여러 세션이 공유하는 이벤트 루프: epoll 스레드 하나가 timerfd 틱과 inotify 파일 변경을 기다리고,
+// 콜백은 고정 크기 작업자 풀에서 실행한다. 스레드 수는 세션 수가 아니라 코어 수에 비례한다.
+// 등록 하나의 콜백은 동시에 두 번 실행되지 않으며, 실행 중에 도착한 이벤트는 한 번의 재실행으로 합쳐진다.
+// 모든 메서드는 스레드 안전하다 (Linux 전용).
+class Reactor {
+public:
+    using Handle = uint64_t;
+    using Callback = std::function<void()>;
+
+    struct Options {
+        size_t num_threads = 0;  // 콜백 작업자 수 (0이면 하드웨어 스레드 수)
+        // inotify 감시가 걸린 파일의 보조 주기 확인 하한 (초, 0이면 inotify만 쓴다).
+        // 확인마다 콜백이 파일을 다시 열므로 세션이 많으면 짧은 주기는 그대로 CPU 비용이 된다
+        double watched_poll_interval = 1.0;
+    };
+
+    Reactor();
+    explicit Reactor(const Options& options);
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // 프로세스 기본 Reactor (기본값 nullptr). 설정 이후 생성되는 EngineCoordinator가 자동으로 사용한다
+    static std::shared_ptr<Reactor> Shared();
+    static void SetShared(std::shared_ptr<Reactor> reactor);
+
+    // interval_seconds마다 callback (첫 실행은 한 주기 뒤). 실패하면 0
+    Handle AddTimer(double interval_seconds, Callback callback);
+    // 파일이 수정될 때 callback. poll_interval_seconds > 0이면 주기적으로도 호출한다
+    // (inotify가 놓치는 교체/네트워크 파일 시스템 대비). inotify 감시가 걸리면 주기는
+    // Options::watched_poll_interval 이상으로 늘리고, 감시가 실패할 때만 poll_interval_seconds 그대로 쓴다. 실패하면 0
+    Handle AddFileWatch(const std::string& path, double poll_interval_seconds, Callback callback);
+    // 반환 후에는 콜백이 실행 중이지도, 다시 실행되지도 않는다 (자기 콜백 안에서 호출하면 기다리지 않는다)
+    void Remove(Handle handle);
+
+    size_t NumWorkers() const { return pool.Size(); }
+
+private:
+    struct Entry {
+        Callback callback;
+        std::vector<int> fds;
+        std::mutex run_mutex;            // 콜백 실행을 직렬화한다
+        std::atomic<bool> queued{false};  // 작업자 풀에 대기 중이거나 실행 중
+        std::atomic<bool> rerun{false};   // 실행 중에 새 이벤트가 왔다
+        bool removed = false;             // run_mutex 보호
+    };
+
+    Handle Register(std::shared_ptr<Entry> entry);
+    void EventLoop();
+    void Dispatch(const std::shared_ptr<Entry>& entry);
+    void Run(const std::shared_ptr<Entry>& entry);
+    static int CreateTimerFd(double interval_seconds);
+
+    Options options;
+    int epoll_fd = -1;
+    int wake_fd = -1;  // 종료 시 루프를 깨우는 eventfd
+    std::atomic<bool> running{false};
+    std::unique_ptr<std::thread> loop_thread;
+
+    std::mutex entries_mutex;
+    std::unordered_map<Handle, std::shared_ptr<Entry>> entries;
+    Handle next_handle = 1;
+
+    ThreadPool pool;
+};
+
+} // namespace realtime_engine_ko
@@ -7,6 +7,10 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <fstream>
+#include <future>
+#include <optional>
 #include <nlohmann/json.hpp>
 
 #include "sentence_block.h"
@@ -14,6 +18,14 @@
 #include "audio_processor.h"
 #include "w2v_onnx_core.h"
 #include "eval_manager.h"
+#include "result_types.h"
+#include "result_json_writer.h"
+#include "result_msgpack_writer.h"
+#include "inference_scheduler.h"
+#include "reactor.h"
+#include "plan_cache.h"
+#include "frame_store.h"
+#include "stage_metrics.h"
 
 namespace realtime_engine_ko {
 
@@ -39,6 +51,40 @@ public:
     ScoreCallback on_score;
 };
 
+// 비동기 평가 취소 토큰 (어느 스레드에서나 Cancel 가능)
+class CancellationToken {
+public:
+    void Cancel() { cancelled = true; }
+    bool IsCancelled() const { return cancelled; }
+    
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+// 비동기 평가 완료 콜백: 완료를 확정한 스레드(청크 처리/틱/API 호출 스레드)에서 한 번 호출된다
+using CompletionCallback = std::function<void(const EngineState&)>;
+
+// ResultMap(std::map<std::string, std::any>)을 JSON으로 변환
+nlohmann::json ResultMapToJson(const std::map<std::string, std::any>& map);
+
+// on_score 이벤트 형식
+enum class ScoreEventMode {
+    FULL,   // 매 이벤트마다 전체 결과 ({"result": {...}})
+    DELTA   // 직전 이벤트 이후 바뀐 블록만 + 시퀀스 번호 (첫 이벤트와 요청 시 스냅샷)
+};
+
+// 결과 직렬화 형식
+enum class ResultEncoding {
+    JSON,     // UTF-8 JSON 문자열
+    MSGPACK   // [4바이트 big-endian 길이][MessagePack 본문] (on_score의 std::string은 바이너리 버퍼)
+};
+
+// 실시간 청크 매칭 방식
+enum class AlignmentMode {
+    WINDOW,      // 청크마다 활성 윈도우 블록을 각각 채점해 최적 블록을 고른다
+    INCREMENTAL  // 지금까지의 오디오를 문장 전체 토큰에 이어서 정렬하고 지나간 블록을 한 번씩 확정한다
+};
+
 class EngineCoordinator {
 public:
     EngineCoordinator(
@@ -48,16 +94,65 @@ public:
         float update_interval = 0.3f,
         float confidence_threshold = 0.7f);
     
+    // 이미 로드된 모델을 여러 코디네이터가 공유할 때 사용
+    EngineCoordinator(
+        std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+        float update_interval = 0.3f,
+        float confidence_threshold = 0.7f);
+    
     ~EngineCoordinator();
     
     void SetRecordListener(const RecordListener& record_listener);
+    void SetScoreEventMode(ScoreEventMode mode);
+    // DELTA 모드에서 다음 on_score 이벤트를 전체 블록 스냅샷으로 보낸다 (클라이언트 재동기화용)
+    void RequestSnapshot();
+    void SetResultEncoding(ResultEncoding encoding);
+    // 실시간 청크 추론을 여러 세션이 공유하는 EDF 스케줄러로 넘긴다 (평가 중이 아닐 때 호출).
+    // latency_slo: 오디오 도착부터 점수 계산까지의 목표 시간(초). nullptr이면 청크를 받은 스레드에서 바로 처리
+    void SetInferenceScheduler(std::shared_ptr<InferenceScheduler> scheduler, float latency_slo = 0.5f);
+    InferenceScheduler::SessionStats GetSchedulingStats() const;
+    // 스케줄러에 쌓인 이 세션의 청크가 max_pending개 이하가 될 때까지 최대 timeout_seconds 기다린다.
+    // 스케줄러로 넘기지 않는 중이면 바로 true (스트리밍 입력의 흐름 제어용)
+    bool WaitForPendingChunks(size_t max_pending, double timeout_seconds);
+    // 이 세션의 단계별 지연 히스토그램 (코디네이터 생성 이후 누적, 프로세스 전체는 StageMetrics::Global())
+    StageMetrics::Snapshot GetMetrics() const;
+    // 파일 감시와 틱을 세션 전용 스레드 대신 공유 Reactor에 등록한다 (평가 중이 아닐 때 호출, nullptr이면 스레드 사용).
+    // 청크 평가는 Reactor 작업자(스케줄러가 있으면 스케줄러 작업자)에서 실행된다.
+    // 기본값은 생성 시점의 Reactor::Shared()이고, 스트림 입력에서는 on_tick이 있을 때 틱만 등록한다
+    void SetReactor(std::shared_ptr<Reactor> reactor);
+    // Initialize가 컴파일된 문장 계획을 찾는 캐시 (기본값 PlanCache::Global(), nullptr이면 매번 컴파일)
+    void SetPlanCache(std::shared_ptr<PlanCache> plan_cache);
+    // 실시간 매칭에서 전체 정렬할 후보를 고르는 키워드 검출 margin (다음 Initialize부터 적용, 음수면 끔, 기본 끔)
+    void SetCandidateMargin(float margin);
+    // 다음 Initialize부터 적용 (장문 EvaluateLongForm은 항상 세그먼트 병합을 쓴다)
+    void SetAlignmentMode(AlignmentMode mode);
+    // 세션 프레임 저장소 (다음 Initialize부터 적용, max_bytes 0이면 끔, 기본 끔). RescoreBlock을 쓰려면 켠다
+    void SetFrameStoreOptions(const FrameStore::Options& options);
+    // 보관된 오디오 구간 [begin_seconds, end_seconds)를 블록에 다시 채점한다 (인코더 재실행 없음, 평가 상태 불변).
+    // 시간은 세션 시작부터 받은 오디오 기준 (VAD로 건너뛴 무음, 스케줄러나 취소로 버린 청크 포함. 장문
+    // EvaluateLongForm만 무음 세그먼트를 뺀 시간축). 프레임 저장소가 꺼져 있거나 구간이 이미 버려졌으면 nullopt
+    std::optional<GopResult> RescoreBlock(int block_id, double begin_seconds, double end_seconds) const;
+    // 장문 모드 (다음 Initialize부터 적용, resident_blocks 0이면 끔): 활성 블록보다 resident_blocks 이상 뒤처진
+    // 블록은 결과를 spill_path에 JSON 한 줄씩 기록하고 메모리에서 내린다. 점수 이벤트/상태의 단어·블록 목록은
+    // 상주 블록만 담고, 점수와 완료 수는 전체 누적 집계다. DELTA 스냅샷도 상주 블록만 보낸다
+    void SetLongFormMode(size_t resident_blocks, const std::string& spill_path = "");
     bool Initialize(const std::string& sentence, float audio_polling_interval = 0.03f, float min_time_between_evals = 0.5f);
     bool StartEvaluation(const std::string& audio_file_path);
     void StopEvaluation();
-    std::map<std::string, std::any> GetCurrentState() const;
+    // 상태 스냅샷의 복사본. 스냅샷은 세션이 바뀐 뒤 처음 읽을 때 만들며, 청크 처리 중이면 기다리지 않고
+    // 직전 스냅샷을 준다 (추론을 막지도, 추론에 막히지도 않는다)
+    EngineState GetState() const;
+    // 불변 스냅샷 그대로 (복사 없이 여러 번 읽을 때)
+    std::shared_ptr<const EngineState> GetStateSnapshot() const;
+    std::map<std::string, std::any> GetCurrentState() const;  // GetState()의 맵 호환 형식
     void Reset();
     
     // 외부 API 메서드
+    EngineState EvaluateSpeechState(
+        const std::string& sentence,
+        const std::string& audio_file_path,
+        const RecordListener& record_listener = RecordListener());
+    
     std::map<std::string, std::any> EvaluateSpeech(
         const std::string& sentence,
         const std::string& audio_file_path,
@@ -65,9 +160,71 @@ public:
     
     std::map<std::string, std::any> GetResults() const;
     
+    // 비동기 평가: 평가를 시작하고 바로 반환한다. 반환된 future와 on_complete는 다음 중 처음 일어난 일로 한 번 완료된다.
+    //   status "completed": 문장의 모든 블록이 평가됨 (result 포함)
+    //   status "stopped": 문장을 끝내기 전에 StopEvaluation/Reset/소멸 (result 포함)
+    //   status "cancelled": cancel->Cancel() 또는 CancelEvaluation() (다음 틱에 확정, 이후 청크는 평가하지 않는다)
+    //   status "busy" / "initialization_failed" / "start_failed": 시작 실패 (즉시 완료)
+    // 완료 후에도 모니터링은 계속되므로 세션 정리는 StopEvaluation/Reset으로 한다 (on_complete 안에서는 호출 금지)
+    std::future<EngineState> EvaluateSpeechAsync(
+        const std::string& sentence,
+        const std::string& audio_file_path,
+        const RecordListener& record_listener = RecordListener(),
+        CompletionCallback on_complete = nullptr,
+        std::shared_ptr<CancellationToken> cancel = nullptr);
+    // 진행 중인 비동기 평가를 취소한다 (없으면 무시)
+    void CancelEvaluation();
+    
+    // 스트리밍 평가: 파일 대신 PCM을 직접 밀어 넣는다 (데몬 세션 등).
+    // 청크 평가와 on_score 콜백은 PushAudio를 호출한 스레드에서 실행된다.
+    bool StartStream(const std::string& sentence, int input_sample_rate = 16000, int channels = 1);
+    void PushAudio(const float* interleaved, size_t frames);
+    EngineState FinishStream();
+    
+    // MessagePack 결과 (세션 소유 버퍼, 다음 *Binary 호출 전까지 유효)
+    const std::string& GetResultsBinary();
+    const std::string& EvaluateSpeechBinary(
+        const std::string& sentence,
+        const std::string& audio_file_path,
+        const RecordListener& record_listener = RecordListener());
+    
+    // 오프라인 평가: 모니터링/타이머 스레드 없이 파일 전체를 동기 처리하고 최종 결과 반환
+    std::map<std::string, std::any> EvaluateFile(
+        const std::string& sentence,
+        const std::string& audio_file_path,
+        bool chunked = true,
+        const RecordListener& record_listener = RecordListener());
+    
+    // 장문 오프라인 평가: 무음 지점에서 분할한 세그먼트를 스레드 풀에서 병렬 추론한 뒤
+    // 문장 블록 목록에 순서대로 병합한다. num_threads=0이면 하드웨어 스레드 수를 사용한다.
+    std::map<std::string, std::any> EvaluateLongForm(
+        const std::string& sentence,
+        const std::string& audio_file_path,
+        size_t num_threads = 0,
+        const RecordListener& record_listener = RecordListener());
+    
 private:
     void TimerLoop();
+    void Tick();
+    // 세션 객체들을 읽어 상태를 만든다. state_mutex를 잡은 채로(또는 세션을 변경하는 스레드에서만) 호출
+    EngineState BuildState() const;
+    // 세션이 바뀌었음을 표시하고 틱 진행 값만 갱신한다 (스냅샷은 GetStateSnapshot이 처음 읽을 때 만든다)
+    void PublishState();
     void OnNewChunk(const AudioProcessor::AudioTensor& audio_chunk, const std::map<std::string, std::any>& metadata);
+    void ProcessChunk(const AudioProcessor::AudioTensor& audio_chunk, const std::map<std::string, std::any>& metadata);
+    void DetachScheduler();
+    void EmitScoreEvent(const EvaluationResult& result);
+    void FinishAlignment();
+    void CompleteEvaluation(EngineState state);
+    
+    // 완료를 기다리는 비동기 평가
+    struct PendingEvaluation {
+        std::promise<EngineState> promise;
+        CompletionCallback on_complete;
+        std::shared_ptr<CancellationToken> cancel;
+    };
+    // 콜백을 부르고 future를 완료한다 (pending_evaluation에서 이미 꺼냈거나 등록하지 않은 것만)
+    static void ResolvePending(PendingEvaluation& pending, EngineState state);
     
     std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine;
     std::shared_ptr<SentenceBlockManager> sentence_manager;
@@ -82,6 +239,54 @@ private:
     std::unique_ptr<std::thread> timer_thread;
     
     RecordListener record_listener;
+    ResultJsonWriter score_writer;  // on_score JSON 재사용 버퍼 (세션당 하나)
+    ResultMsgpackWriter score_msgpack_writer;  // on_score MessagePack 재사용 버퍼
+    ResultMsgpackWriter api_msgpack_writer;    // *Binary API 반환 버퍼
+    std::atomic<ResultEncoding> result_encoding;
+    
+    // 델타 점수 이벤트 상태
+    std::atomic<ScoreEventMode> score_event_mode;
+    std::atomic<bool> snapshot_requested;
+    uint64_t score_seq;
+    std::vector<uint64_t> sent_block_revisions;  // 블록별 마지막으로 보낸 revision
+    ScoreDelta score_delta;  // 재사용 (블록 벡터 용량 유지)
+    
+    // 세션 간 추론 스케줄러 (실시간 경로에서만 사용, 오프라인 평가는 결정성을 위해 직접 처리)
+    std::shared_ptr<InferenceScheduler> scheduler;
+    InferenceScheduler::SessionId scheduler_session;
+    std::atomic<bool> schedule_chunks;
+    
+    // 공유 이벤트 루프 (설정되면 timer_thread/모니터링 스레드 대신 사용)
+    std::shared_ptr<Reactor> reactor;
+    Reactor::Handle tick_timer;
+    Reactor::Handle file_watch;
+    
+    std::shared_ptr<PlanCache> plan_cache;
+    float candidate_margin;
+    AlignmentMode alignment_mode;
+    FrameStore::Options frame_store_options;
+    
+    // 상태 스냅샷: 변경 스레드는 state_dirty만 세우고, 바뀐 뒤 처음 읽는 쪽이 state_mutex를 try_lock해
+    // 새 객체를 만들어 atomic_store로 교체한다 (청크마다 O(블록) 복사를 하지 않는다). 읽는 쪽은 atomic_load만 한다.
+    // 세션 객체를 바꾸는 구간(청크 평가, 정렬 마무리, 세그먼트 병합, Initialize, Reset)은 state_mutex를 잡는다
+    mutable std::shared_ptr<const EngineState> state_snapshot;
+    mutable std::atomic<bool> state_dirty{false};
+    mutable std::atomic<bool> snapshot_missed{false};  // 처리 중이라 직전 스냅샷을 준 적이 있다
+    mutable std::mutex state_mutex;
+    std::atomic<int> tick_block{0};          // 틱 진행 표시 (현재 블록, 1부터)
+    std::atomic<int> tick_total_blocks{-1};  // -1이면 초기화 전
+    // 시작하는 쪽은 비어 있을 때만 CAS로 등록하고, 완료한 스레드가 atomic_exchange로 꺼내므로 정확히 한 번 완료된다
+    std::shared_ptr<PendingEvaluation> pending_evaluation;
+    std::atomic<bool> evaluation_cancelled;  // 취소로 완료된 뒤 남은 청크를 버린다 (다음 Initialize/StartEvaluation까지)
+    
+    // 단계별 지연 (기록은 StageMetrics::Global()에도 반영된다)
+    StageMetrics stage_metrics;
+    
+    // 장문 모드
+    size_t resident_blocks;
+    std::string spill_path;
+    std::unique_ptr<std::ofstream> spill_stream;
+    ResultJsonWriter spill_writer;
 };
 
 } // namespace realtime_engine_ko
\ No newline at end of file
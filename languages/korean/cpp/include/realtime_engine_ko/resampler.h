@@ -0,0 +1,44 @@
+// resampler.h
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+
+namespace realtime_engine_ko {
+
+// 스트리밍 polyphase 리샘플러 (다채널 → 모노 다운믹스 포함)
+// 입력 L/M 비율로 변환하며, 필터 히스토리를 호출 사이에 유지한다.
+class PolyphaseResampler {
+public:
+    PolyphaseResampler(int input_rate, int output_rate, int channels = 1, int taps_per_phase = 32);
+
+    // 인터리브된 입력 프레임을 다운믹스/리샘플링하여 out 뒤에 추가
+    void Process(const float* interleaved, size_t num_frames, std::vector<float>& out);
+    void Reset();
+
+    int GetInputRate() const { return input_rate; }
+    int GetOutputRate() const { return output_rate; }
+    int GetChannels() const { return channels; }
+    bool IsPassthrough() const { return up == 1 && down == 1; }
+
+private:
+    void DesignFilter();
+
+    int input_rate;
+    int output_rate;
+    int channels;
+    int taps_per_phase;
+    int up;    // L (보간 비율)
+    int down;  // M (데시메이션 비율)
+
+    // [taps_per_phase x up] - 각 열이 하나의 위상 필터 (히스토리와 바로 내적하도록 역순 저장)
+    Eigen::MatrixXf phase_filters;
+
+    // 모노 입력 히스토리 (앞쪽 taps_per_phase - 1 샘플은 이전 호출에서 이어짐)
+    std::vector<float> history;
+    size_t next_base;  // 다음 출력 샘플이 참조하는 history 내 마지막 입력 인덱스
+    int next_phase;    // 다음 출력 샘플의 위상 (0 <= next_phase < up)
+};
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,40 @@
+// result_json_writer.h
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "result_types.h"
+
+namespace realtime_engine_ko {
+
+// 결과 구조체를 JSON DOM 없이 재사용 버퍼에 바로 기록한다.
+// 키 순서, 이스케이프, 실수 표기(고정/지수 구간, ".0", e+XX)는 ResultMapToJson(ToMap(...)).dump()와 같다.
+// 실수 자릿수는 std::to_chars의 최단 왕복 표현이라 dump()와 마지막 자리가 다를 수 있지만, 모든 값은 같은 double로 파싱된다.
+// 세션(코디네이터)마다 하나씩 두고 재사용하며, 스레드 안전하지 않다.
+class ResultJsonWriter {
+public:
+    explicit ResultJsonWriter(size_t initial_capacity = 4096);
+
+    // 반환된 참조는 같은 writer의 다음 Write 호출 전까지 유효하다
+    const std::string& Write(const EvaluationResult& result);  // {"result": {...}}
+    const std::string& Write(const EngineState& state);        // GetCurrentState() 형식
+    const std::string& Write(const ScoreDelta& delta);         // 델타/스냅샷 점수 이벤트
+    const std::string& Write(const BlockResult& block);        // 블록 하나 (장문 모드 spill 기록)
+
+    const std::string& Buffer() const { return buffer; }
+
+private:
+    void WriteResultObject(const EvaluationResult& result);
+    void WriteSummaryFields(const EvaluationSummary& summary);
+    void WriteBlock(const BlockResult& block);
+    void WriteKey(const char* key);
+    void WriteString(const std::string& value);
+    void WriteFloat(double value);
+    void WriteInt(int64_t value);
+    void WriteUInt(uint64_t value);
+    void WriteBool(bool value);
+
+    std::string buffer;
+};
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,33 @@
+// result_msgpack_writer.h
+#pragma once
+
+#include <string>
+#include "result_types.h"
+
+namespace realtime_engine_ko {
+
+// 결과 구조체를 MessagePack으로 재사용 버퍼에 기록한다.
+// 버퍼 형식: [본문 길이 4바이트 big-endian][MessagePack 본문]
+// 스키마(키 이름, 중첩 구조)는 ResultJsonWriter와 같고, 점수는 float32, epoch 초는 float64로 기록한다.
+// 세션마다 하나씩 두고 재사용하며, 스레드 안전하지 않다.
+class ResultMsgpackWriter {
+public:
+    static constexpr size_t kLengthPrefixSize = 4;
+
+    explicit ResultMsgpackWriter(size_t initial_capacity = 4096);
+
+    // 반환된 참조는 같은 writer의 다음 Write 호출 전까지 유효하다
+    const std::string& Write(const EvaluationResult& result);  // {"result": {...}}
+    const std::string& Write(const EngineState& state);        // GetCurrentState() 형식
+    const std::string& Write(const ScoreDelta& delta);         // 델타/스냅샷 점수 이벤트
+
+    const std::string& Buffer() const { return buffer; }
+
+private:
+    void Begin();
+    const std::string& Finish();
+
+    std::string buffer;
+};
+
+} // namespace realtime_engine_ko
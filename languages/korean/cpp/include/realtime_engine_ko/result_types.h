@@ -0,0 +1,106 @@
+// result_types.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <map>
+#include <any>
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+
+namespace realtime_engine_ko {
+
+// 단어(또는 블록) 하나의 발음 점수
+struct WordScore {
+    std::string word;
+    float pronunciation = 0.0f;
+};
+
+// 텍스트 하나에 대한 GOP 계산 결과 (단어 점수는 정수로 반올림됨)
+struct GopResult {
+    float overall = 0.0f;
+    float pronunciation = 0.0f;
+    std::vector<WordScore> words;
+};
+
+// 문장 블록 하나의 평가 상태
+struct BlockResult {
+    int block_id = -1;
+    std::string text;
+    std::string status;
+    std::optional<float> gop_score;
+    std::optional<float> confidence;
+    std::optional<double> recognized_at;  // epoch 초
+    std::optional<double> evaluated_at;   // epoch 초
+};
+
+struct ScoreBreakdown {
+    float min_score = 0.0f;
+    float max_score = 0.0f;
+};
+
+// 모든 블록 평가 완료 시 추가되는 정보
+struct ResultDetails {
+    size_t total_blocks = 0;
+    std::time_t completion_time = 0;
+    ScoreBreakdown score_breakdown;
+};
+
+// 세션 평가 결과 ({"result": {...}}의 안쪽)
+struct EvaluationResult {
+    float overall = 0.0f;
+    float pronunciation = 0.0f;
+    std::string resource_version = "1.0.0";
+    std::vector<WordScore> words;
+    bool eof = false;
+    std::optional<float> final_score;
+    std::optional<ResultDetails> details;
+};
+
+// 평가 진행 요약
+struct EvaluationSummary {
+    float overall_score = 0.0f;
+    size_t completed = 0;
+    size_t total = 0;
+    std::vector<BlockResult> blocks;  // 평가된 블록이 없으면 비어 있다
+};
+
+struct AudioStats {
+    int total_chunks = 0;
+    int silent_chunks = 0;
+};
+
+// 엔진 상태 (GetCurrentState / Evaluate* 반환 값)
+struct EngineState {
+    std::string status;
+    bool initialized = false;  // false면 status만 의미가 있다
+    int current_block = 0;
+    size_t total_blocks = 0;
+    std::optional<AudioStats> audio;
+    std::optional<EvaluationSummary> summary;
+    std::optional<EvaluationResult> result;  // 오프라인 평가 완료 시 최종 결과
+};
+
+// 델타 점수 이벤트: 직전 이벤트 이후 바뀐 블록만 담는다 (snapshot이면 전체 블록)
+struct ScoreDelta {
+    uint64_t seq = 0;
+    bool snapshot = false;
+    float overall = 0.0f;
+    float pronunciation = 0.0f;
+    bool eof = false;
+    size_t completed = 0;
+    size_t total = 0;
+    std::vector<BlockResult> blocks;
+};
+
+// API 경계용 호환 어댑터: 기존 std::map<std::string, std::any> 형식으로 변환
+std::map<std::string, std::any> ToMap(const WordScore& word, bool integral_score);
+std::map<std::string, std::any> ToMap(const GopResult& result);
+std::map<std::string, std::any> ToMap(const BlockResult& block);
+std::map<std::string, std::any> ToMap(const EvaluationResult& result);
+std::map<std::string, std::any> ToMap(const EvaluationSummary& summary);
+std::map<std::string, std::any> ToMap(const EngineState& state);
+
+} // namespace realtime_engine_ko
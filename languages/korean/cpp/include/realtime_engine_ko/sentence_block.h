@@ -8,6 +8,9 @@
 #include <map>
 #include <chrono>
 #include <any>
+#include <cstdint>
+#include <limits>
+#include "result_types.h"
 
 namespace realtime_engine_ko {
 
@@ -26,6 +29,7 @@ public:
     void SetScore(float score);
     void SetConfidence(float confidence);
     
+    BlockResult ToResult() const;
     std::map<std::string, std::any> ToDict() const;
     
     std::string text;
@@ -35,11 +39,26 @@ public:
     std::optional<float> confidence;
     std::optional<std::chrono::system_clock::time_point> recognized_at;
     std::optional<std::chrono::system_clock::time_point> evaluated_at;
+    uint64_t revision;  // 상태/점수가 바뀔 때마다 증가 (델타 이벤트용)
 };
 
 class SentenceBlockManager {
 public:
+    // 평가 완료 블록 점수의 누적 집계 (블록 상태/점수가 바뀔 때 O(1)로 갱신)
+    struct Aggregates {
+        size_t completed = 0;
+        double score_sum = 0.0;
+        float min_score = std::numeric_limits<float>::max();
+        float max_score = -std::numeric_limits<float>::max();
+        int last_evaluated = -1;  // 평가된 블록 중 가장 큰 ID
+    };
+    
     SentenceBlockManager(const std::string& sentence, const std::string& delimiter = " ");
+    // 이미 분할된 블록 텍스트로 생성 (컴파일된 문장 계획 재사용 시)
+    explicit SentenceBlockManager(const std::vector<std::string>& block_texts);
+    
+    // 문장을 블록 텍스트로 분할 (앞뒤 공백 제거, 빈 블록 제외)
+    static std::vector<std::string> SplitBlocks(const std::string& sentence, const std::string& delimiter = " ");
     
     std::shared_ptr<SentenceBlock> GetBlock(int block_id) const;
     std::shared_ptr<SentenceBlock> GetActiveBlock() const;
@@ -48,11 +67,38 @@ public:
     std::vector<std::shared_ptr<SentenceBlock>> GetWindow(int window_size = 3) const;
     bool UpdateBlockStatus(int block_id, BlockStatus status);
     bool SetBlockScore(int block_id, float score);
+    std::vector<BlockResult> GetAllBlockResults() const;
+    // [begin, end) 범위에서 내려지지 않은 블록의 결과
+    std::vector<BlockResult> GetBlockResults(int begin, int end) const;
     std::vector<std::map<std::string, std::any>> GetAllBlocksStatus() const;
     void Reset();
     
+    const Aggregates& GetAggregates() const { return aggregates; }
+    
+    // 장문 모드: 활성 블록보다 resident_blocks 이상 뒤처진 블록은 결과를 내보내고 메모리에서 내린다 (0이면 끔).
+    // 내려진 블록은 blocks에서 nullptr이 되고 GetBlock도 nullptr을 반환한다
+    void SetResidency(size_t resident_blocks);
+    size_t GetResidency() const { return resident_blocks; }
+    // 새로 내릴 블록들의 최종 결과를 ID 순서로 반환하고 해제한다 (장문 모드가 아니면 빈 벡터)
+    std::vector<BlockResult> SpillFinalized();
+    // 상주 범위 [ResidentBegin, ResidentEnd): 앞쪽은 내려졌고, 뒤쪽은 만들어진 뒤 한 번도 바뀌지 않았다
+    int ResidentBegin() const { return spill_frontier; }
+    int ResidentEnd() const { return touched_end; }
+    
     std::vector<std::shared_ptr<SentenceBlock>> blocks;
     int active_block_id;
+    
+private:
+    void Touch(int block_id);
+    void RecomputeMinMax();
+    
+    Aggregates aggregates;
+    size_t resident_blocks = 0;
+    int spill_frontier = 0;
+    int touched_end = 0;
+    float spilled_min = std::numeric_limits<float>::max();   // 내려진 평가 블록의 최소/최대 점수
+    float spilled_max = -std::numeric_limits<float>::max();
+    std::vector<std::string> spilled_texts;  // Reset에서 내려진 블록을 다시 만들 때 사용
 };
 
 } // namespace realtime_engine_ko
\ No newline at end of file
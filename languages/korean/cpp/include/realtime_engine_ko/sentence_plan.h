@@ -0,0 +1,66 @@
+// sentence_plan.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace realtime_engine_ko {
+
+class Wav2VecCTCOnnxCore;
+
+// 토큰화된 텍스트 하나 (ScoreText가 매번 하던 Encode, IdToToken, 단어 분할 결과)
+struct TokenSequence {
+    // 단어 = '|' 사이의 연속 토큰 [begin, end)
+    struct Word {
+        std::string text;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<int> ids;
+    std::vector<std::string> strings;
+    std::vector<Word> words;
+    
+    size_t MemoryBytes() const;
+};
+
+// 블록 하나의 컨텍스트 포함 평가 계획 (CalculateGopWithContext와 같은 규칙)
+struct BlockPlan {
+    TokenSequence context_tokens;  // 앞 블록 + 대상 블록 + 뒤 블록
+    TokenSequence target_tokens;   // 컨텍스트 결과에서 대상 단어를 찾지 못할 때 사용
+    int target_word_index = 0;     // 컨텍스트 단어 중 대상 블록의 시작 위치
+    int target_word_count = 0;
+};
+
+// 문장 하나에 대해 Initialize에서 한 번만 만드는 불변 평가 계획. 청크 처리는 읽기만 한다
+struct SentencePlan {
+    static constexpr int kContextBlocks = 2;  // 앞뒤로 붙이는 컨텍스트 블록 수
+
+    std::vector<std::string> block_texts;
+    std::vector<int> block_syllables;  // 블록별 음절(공백 제외 UTF-8 문자) 수, 발화 속도 추정용
+    std::vector<BlockPlan> blocks;
+
+    // 블록 토큰을 '|'로 이어 붙인 문장 전체 토큰 (장문 세그먼트 정렬용)
+    TokenSequence sentence_tokens;
+    std::vector<std::pair<size_t, size_t>> block_token_spans;  // 블록별 [first, second)
+    std::vector<int> token_blocks;                             // 토큰별 블록 ID (구분자는 -1)
+
+    // 캐시 메모리 상한 계산용 대략적인 크기
+    size_t MemoryBytes() const;
+
+    static std::shared_ptr<const SentencePlan> Compile(
+        Wav2VecCTCOnnxCore& engine,
+        const std::vector<std::string>& block_texts);
+
+    // 저장된 토큰 ID로 복원 (토크나이저 인코딩을 거치지 않는다)
+    static std::shared_ptr<const SentencePlan> FromTokenIds(
+        Wav2VecCTCOnnxCore& engine,
+        const std::vector<std::string>& block_texts,
+        const std::vector<std::vector<int>>& context_ids,
+        const std::vector<std::vector<int>>& target_ids,
+        const std::vector<std::pair<int, int>>& target_words);  // (target_word_index, target_word_count)
+};
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,129 @@
+// stage_metrics.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace realtime_engine_ko {
+
+// 청크 처리 경로의 단계 (지연 분석 단위). 단계끼리 겹치지 않게 측정하고 CHUNK만 청크 전체를 잰다
+enum class Stage : size_t {
+    INGEST,      // 파일 읽기/스트림 입력 + 리샘플링
+    PREPROCESS,  // VAD 게이트 + 정규화
+    INFERENCE,   // ORT Session::Run
+    SOFTMAX,     // 출력 텐서 복사 + softmax
+    ALIGN,       // DTW (블록 정렬, 증분 정렬)
+    SCORE,       // 토큰 점수/정규화/단어 그룹화, 키워드 검출
+    SERIALIZE,   // on_score 결과 직렬화
+    CHUNK,       // 청크 하나의 평가 전체 (추론~이벤트)
+    COUNT
+};
+
+constexpr size_t kNumStages = static_cast<size_t>(Stage::COUNT);
+const char* StageName(Stage stage);
+
+// HDR 방식 로그-선형 지연 히스토그램 (나노초): 2의 거듭제곱 구간마다 8개 하위 버킷 (상대 오차 12.5% 이하).
+// Record는 relaxed 원자 증가만 하므로 여러 스레드에서 잠금 없이 기록할 수 있다
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxMagnitude = 40;  // 2^40ns ≈ 18분, 이상은 마지막 버킷
+    static constexpr size_t kNumBuckets = kSubBuckets + (kMaxMagnitude - kSubBucketBits + 1) * kSubBuckets;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+        std::vector<uint64_t> buckets;  // kNumBuckets개
+
+        double MeanSeconds() const;
+        // q ∈ [0, 1] 분위수 (버킷 상한, max로 제한한 값, 초)
+        double PercentileSeconds(double q) const;
+        // value_ns 이하로 기록된 수 (value_ns가 버킷 상한, 예: 2의 거듭제곱 - 1이면 정확)
+        uint64_t CountAtMost(uint64_t value_ns) const;
+    };
+
+    LatencyHistogram();
+
+    void Record(uint64_t nanoseconds);
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+    static size_t BucketIndex(uint64_t nanoseconds);
+    static uint64_t BucketUpperBound(size_t index);  // 버킷에 들어가는 최대값 (ns)
+
+private:
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets;
+    std::atomic<uint64_t> sum_ns;
+    std::atomic<uint64_t> max_ns;
+};
+
+// 단계별 히스토그램 묶음. 세션마다 하나씩 두고, 기록은 프로세스 전체 Global()에도 함께 반영된다.
+// 공유 코어(Wav2VecCTCOnnxCore 등)는 어느 세션인지 모르므로 Scope로 현재 스레드의 세션 지표를 지정한다
+class StageMetrics {
+public:
+    struct Snapshot {
+        std::array<LatencyHistogram::Snapshot, kNumStages> stages;
+    };
+
+    // 현재 스레드의 기록 대상 지정 (중첩 가능, 소멸 시 이전 대상으로 복원)
+    class Scope {
+    public:
+        explicit Scope(StageMetrics* metrics);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StageMetrics* previous;
+    };
+
+    StageMetrics();
+    explicit StageMetrics(StageMetrics* parent);
+
+    void Record(Stage stage, uint64_t nanoseconds);
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+    static StageMetrics& Global();
+    // Scope로 지정된 세션 지표, 없으면 Global()
+    static StageMetrics& Current();
+
+private:
+    std::array<LatencyHistogram, kNumStages> stages;
+    StageMetrics* parent;
+};
+
+// 생성부터 소멸까지를 현재 스레드의 지표(StageMetrics::Current())에 기록
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(Stage stage)
+        : metrics(StageMetrics::Current()), stage(stage), start(std::chrono::steady_clock::now()) {}
+    ~ScopedStageTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        metrics.Record(stage, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    StageMetrics& metrics;
+    Stage stage;
+    std::chrono::steady_clock::time_point start;
+};
+
+// 스냅샷 직렬화: JSON {"stages": {"<stage>": {"count", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "max_ms"}}}
+std::string MetricsToJson(const StageMetrics::Snapshot& snapshot);
+// Prometheus 텍스트 형식 (realtime_engine_stage_seconds 히스토그램, 단계는 stage 레이블).
+// session이 비어 있지 않으면 session 레이블을 붙인다 (여러 세션을 함께 수집할 때 시계열 구분)
+std::string MetricsToPrometheus(const StageMetrics::Snapshot& snapshot, const std::string& scope = "process",
+                                const std::string& session = "");
+
+} // namespace realtime_engine_ko
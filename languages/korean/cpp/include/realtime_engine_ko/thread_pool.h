@@ -0,0 +1,59 @@
+// thread_pool.h
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace realtime_engine_ko {
+
+// 고정 크기 작업자 스레드 풀
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    auto Submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    size_t Size() const { return workers.size(); }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping;
+};
+
+template <typename F>
+auto ThreadPool::Submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using ResultType = std::invoke_result_t<std::decay_t<F>>;
+
+    // std::function은 복사 가능해야 하므로 packaged_task를 shared_ptr로 감싼다
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+    std::future<ResultType> future = task->get_future();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (stopping) {
+            throw std::runtime_error("종료 중인 ThreadPool에 작업을 추가할 수 없습니다.");
+        }
+        tasks.emplace([task]() { (*task)(); });
+    }
+    queue_cv.notify_one();
+    return future;
+}
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,50 @@
+// voice_activity_detector.h
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+
+namespace realtime_engine_ko {
+
+// 스트리밍 VAD: 10ms 프레임 단위 에너지/영교차율 판정 + hangover 스무딩
+// 청크 경계를 넘어 프레임 정렬과 hangover 상태를 유지한다.
+class VoiceActivityDetector {
+public:
+    VoiceActivityDetector(
+        int sample_rate = 16000,
+        float frame_duration = 0.01f,
+        float energy_threshold = 0.0005f,
+        float max_zero_crossing_rate = 0.35f,
+        int min_speech_frames = 10,
+        int onset_frames = 3,
+        int hangover_frames = 8);
+
+    // 청크를 스트리밍으로 처리하고 음성 포함 여부 반환
+    bool ProcessChunk(const float* samples, size_t num_samples);
+
+    // 프레임별 에너지/영교차율 계산 (상태 없음, 불완전한 마지막 프레임은 무시)
+    void ComputeFrameFeatures(const float* samples, size_t num_samples,
+                              Eigen::VectorXf& energies, Eigen::VectorXf& zero_crossing_rates) const;
+
+    void Reset();
+    int GetFrameSize() const { return frame_size; }
+    float GetEnergyThreshold() const { return energy_threshold; }
+
+private:
+    bool ClassifyFrame(float energy, float zero_crossing_rate);
+
+    int frame_size;
+    float energy_threshold;
+    float max_zero_crossing_rate;
+    int min_speech_frames;
+    int onset_frames;
+    int hangover_frames;
+
+    // 청크 사이에 유지되는 상태
+    int consecutive_speech;
+    int hangover_remaining;
+    std::vector<float> pending_samples;  // 이전 청크에서 남은 불완전 프레임
+};
+
+} // namespace realtime_engine_ko
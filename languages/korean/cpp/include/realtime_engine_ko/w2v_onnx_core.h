@@ -7,9 +7,12 @@
 #include <map>
 #include <any>
 #include <optional>
+#include <mutex>
 #include <Eigen/Dense>
 #include <onnxruntime_cxx_api.h>
 #include <tokenizers_cpp.h>
+#include "result_types.h"
+#include "sentence_plan.h"
 
 namespace realtime_engine_ko {
 
@@ -18,24 +21,99 @@ public:
     using MatrixXf = Eigen::MatrixXf;
     using VectorXf = Eigen::VectorXf;
     
+    // 인코더 입력 샘플레이트 (오디오는 이 레이트 모노로 변환해 넣는다)
+    static constexpr int kSampleRate = 16000;
+    
+    // 인코더 출력 (프레임 × 히든, 프레임 × 어휘 확률)
+    struct EncoderOutput {
+        MatrixXf hidden;
+        MatrixXf probs;
+    };
+    
+    // 세그먼트-블록 정렬 결과 (후보 블록 하나당 하나)
+    struct SegmentBlockScore {
+        float score = 0.0f;     // 0~100 발음 점수
+        float coverage = 0.0f;  // 프레임이 정렬된 토큰 비율
+    };
+    
     Wav2VecCTCOnnxCore(const std::string& onnx_model_path, 
                        const std::string& tokenizer_path,
                        const std::string& device = "CPU");
     
-    std::pair<std::vector<int>, std::vector<int>> DtwAlign(const MatrixXf& X, const MatrixXf& Y);
+    // open_end=true면 Y의 앞부분만 소비한 경로도 허용 (세그먼트가 문장 일부만 담을 때)
+    std::pair<std::vector<int>, std::vector<int>> DtwAlign(const MatrixXf& X, const MatrixXf& Y, bool open_end = false);
     std::string Transcribe(const std::string& audio_path, const std::vector<int>& raw_ids);
     float SigmoidWeight(float score, float mid = 35.0f, float steepness = 0.2f);
     float WeightedAvgWithSigmoid(const std::vector<std::pair<std::string, float>>& syllables, 
                                 float mid = 35.0f, float steepness = 0.2f);
-    std::vector<std::map<std::string, std::any>> GroupWordsSigmoid(
+    std::vector<WordScore> GroupWordsSigmoid(
         const std::vector<std::pair<std::string, float>>& syllable_scores);
     
-    std::map<std::string, std::any> CalculateGopFromTensor(
+    // 인코더 추론만 수행 (스레드 안전 - 여러 세그먼트를 병렬로 돌릴 수 있다)
+    EncoderOutput RunEncoder(const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor);
+    
+    // 텍스트 토큰화 + 토큰 문자열/단어 범위 수집 (SentencePlan 컴파일용)
+    TokenSequence CompileTokens(const std::string& text);
+    TokenSequence CompileTokenIds(const std::vector<int>& token_ids);
+    int SeparatorId();
+    
+    // 토크나이저나 ONNX 파일이 바뀌면 달라지는 모델 식별자 (16자리 16진수)
+    const std::string& ModelVersion() const { return model_version; }
+    int VocabSize() const { return static_cast<int>(prototype_matrix.rows()); }
+    
+    // 인코더 출력에 대해 텍스트 GOP 계산
+    GopResult ScoreText(
+        const EncoderOutput& output,
+        const std::string& text,
+        float eps = 1e-8f);
+    
+    // 미리 컴파일된 토큰으로 GOP 계산 (토크나이저를 거치지 않는다)
+    GopResult ScoreTokens(
+        const EncoderOutput& output,
+        const TokenSequence& tokens,
+        float eps = 1e-8f);
+    
+    // CalculateGopWithContext와 같은 결과를 컴파일된 블록 계획으로 계산
+    GopResult ScoreBlock(
+        const EncoderOutput& output,
+        const BlockPlan& block,
+        float eps = 1e-8f);
+    
+    // 정렬 없는 키워드 검출 점수: 토큰별 프레임 최대 로그 확률의 평균 ('|' 제외, 토큰이 없으면 -inf).
+    // 후보 블록 순위를 싸게 매기는 용도이며 0에 가까울수록 해당 토큰들이 발화되었을 가능성이 높다
+    float SpotTokens(
+        const EncoderOutput& output,
+        const TokenSequence& tokens,
+        float eps = 1e-8f) const;
+    
+    // 프레임 × 토큰 유클리드 거리 (토큰 프로토타입 기준, 증분 정렬의 로컬 비용)
+    MatrixXf TokenDistances(const MatrixXf& hidden, const int* token_ids, size_t num_tokens) const;
+    
+    // 이미 정렬된 토큰별 원시 점수(평균 로그 확률, 정렬 안 됨은 -inf)로 GOP 계산.
+    // [norm_begin, norm_end) 범위로 정규화하고 [begin, end) 안의 단어만 반환한다
+    GopResult ScoreAlignedTokens(
+        const TokenSequence& tokens,
+        const std::vector<float>& raw_scores,
+        size_t norm_begin, size_t norm_end,
+        size_t begin, size_t end,
+        float eps = 1e-8f);
+    
+    // 세그먼트를 후보 블록 열 [first_block, first_block + num_blocks)에 open-end 정렬하고
+    // 블록별 점수/커버리지 반환. expected_blocks: 세그먼트 길이로 추정한 블록 수 (토큰당 프레임 수 추정에 사용)
+    std::vector<SegmentBlockScore> AlignSegmentToBlocks(
+        const EncoderOutput& output,
+        const SentencePlan& plan,
+        int first_block,
+        int num_blocks,
+        int expected_blocks,
+        float eps = 1e-8f);
+    
+    GopResult CalculateGopFromTensor(
         const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor,
         const std::string& text,
         float eps = 1e-8f);
     
-    std::map<std::string, std::any> CalculateGopWithContext(
+    GopResult CalculateGopWithContext(
         const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor,
         const std::string& target_text,
         const std::string& context_before = "",
@@ -43,12 +121,34 @@ public:
         std::optional<int> target_index = std::nullopt);
     
 private:
+    std::vector<int> EncodeText(const std::string& text);
+    // 히든 상태가 없으면 (FrameStore에서 복원한 출력) 사후 확률로 정렬한다
+    std::vector<std::vector<int>> AlignTokenFrames(
+        const EncoderOutput& output,
+        const int* token_ids,
+        size_t num_tokens,
+        int expected_tokens = 0,
+        bool open_end = false);
+    std::vector<float> ScoreTokenFrames(
+        const MatrixXf& probs,
+        const int* token_ids,
+        size_t num_tokens,
+        const std::vector<std::vector<int>>& frames,
+        float eps);
+    std::vector<float> NormalizeScores(const std::vector<float>& raw_scores, float eps);
+    float WeightedAvgOfRange(const std::vector<float>& scores, size_t begin, size_t end);
+    
     float weight_norm_mid = 50.0f;
     float weight_norm_steepness = 0.2f;
     
+    // Env는 세션보다 오래 살아 있어야 한다
+    std::unique_ptr<Ort::Env> env;
     std::unique_ptr<Ort::Session> session;
     std::unique_ptr<tokenizers::Tokenizer> tokenizer;
+    // tokenizers-cpp 핸들은 디코딩 결과를 내부에 보관하므로 여러 세션이 공유할 때 직렬화 필요
+    mutable std::mutex tokenizer_mutex;
     MatrixXf prototype_matrix;
+    std::string model_version;
     
     std::string input_name;
     std::string hidden_name;
@@ -8,6 +8,7 @@ extern "C" {
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 // 불투명 포인터로 C++의 EngineCoordinator 클래스 인스턴스를 참조
 typedef struct EngineCoordinator* EngineCoordinatorHandle;
@@ -18,6 +19,15 @@ typedef void (*TickCallbackFn)(int current, int total);
 typedef void (*FailCallbackFn)(const char* message);
 typedef void (*EndCallbackFn)(void);
 typedef void (*ScoreCallbackFn)(const char* score_json);
+// MessagePack 점수 콜백: data는 [4바이트 big-endian 길이][MessagePack 본문], 콜백 반환 후에는 무효
+typedef void (*BinaryScoreCallbackFn)(const uint8_t* data, size_t size);
+
+// 비동기 평가 완료 콜백: state_json은 최종 상태 JSON (status, result 등), 콜백 반환 후에는 무효
+typedef void (*CompletionCallbackFn)(const char* state_json, void* user_data);
+
+// 결과 직렬화 형식
+#define ENGINE_RESULT_ENCODING_JSON 0
+#define ENGINE_RESULT_ENCODING_MSGPACK 1
 
 /**
  * 엔진 인스턴스 생성
@@ -52,6 +62,43 @@ void engine_set_listener(
     EndCallbackFn on_end,
     ScoreCallbackFn on_score);
 
+/**
+ * MessagePack 점수 콜백을 사용하는 리스너 설정 (결과 형식도 MessagePack으로 전환)
+ * @param handle 엔진 핸들
+ * @param on_start 시작 콜백
+ * @param on_tick 진행 상황 콜백
+ * @param on_fail 실패 콜백
+ * @param on_end 종료 콜백
+ * @param on_score 바이너리 점수 콜백
+ */
+void engine_set_listener_binary(
+    EngineCoordinatorHandle handle,
+    StartCallbackFn on_start,
+    TickCallbackFn on_tick,
+    FailCallbackFn on_fail,
+    EndCallbackFn on_end,
+    BinaryScoreCallbackFn on_score);
+
+/**
+ * on_score 결과 직렬화 형식 설정
+ * @param handle 엔진 핸들
+ * @param encoding ENGINE_RESULT_ENCODING_JSON 또는 ENGINE_RESULT_ENCODING_MSGPACK
+ */
+void engine_set_result_encoding(EngineCoordinatorHandle handle, int encoding);
+
+/**
+ * 점수 이벤트 형식 설정
+ * @param handle 엔진 핸들
+ * @param delta true면 바뀐 블록만 담은 델타 이벤트({"seq", "type", "blocks", ...}), false면 전체 결과
+ */
+void engine_set_score_mode(EngineCoordinatorHandle handle, bool delta);
+
+/**
+ * 다음 점수 이벤트를 전체 블록 스냅샷으로 요청 (델타 모드 재동기화)
+ * @param handle 엔진 핸들
+ */
+void engine_request_snapshot(EngineCoordinatorHandle handle);
+
 /**
  * 엔진 초기화
  * @param handle 엔진 핸들
@@ -91,10 +138,18 @@ void engine_reset(EngineCoordinatorHandle handle);
 /**
  * 결과 가져오기
  * @param handle 엔진 핸들
- * @return JSON 형식의 결과 문자열 (메모리 해제 필요)
+ * @return JSON 형식의 전체 상태 문자열 (progress/audio/blocks 등 중첩 필드 포함, 메모리 해제 필요)
  */
 const char* engine_get_results(EngineCoordinatorHandle handle);
 
+/**
+ * 결과 가져오기 (MessagePack)
+ * @param handle 엔진 핸들
+ * @param size 버퍼 크기(길이 접두사 포함)를 받을 포인터
+ * @return [4바이트 길이][MessagePack] 버퍼. 엔진이 소유하며 다음 *_binary 호출 전까지 유효 (해제 금지)
+ */
+const uint8_t* engine_get_results_binary(EngineCoordinatorHandle handle, size_t* size);
+
 /**
  * 음성 평가 (한번에 모든 과정 처리)
  * @param handle 엔진 핸들
@@ -107,6 +162,81 @@ const char* engine_evaluate_speech(
     const char* sentence,
     const char* audio_file_path);
 
+/**
+ * 음성 평가 (MessagePack 결과)
+ * @param handle 엔진 핸들
+ * @param sentence 평가할 문장
+ * @param audio_file_path 오디오 파일 경로
+ * @param size 버퍼 크기(길이 접두사 포함)를 받을 포인터
+ * @return [4바이트 길이][MessagePack] 버퍼. 엔진이 소유하며 다음 *_binary 호출 전까지 유효 (해제 금지)
+ */
+const uint8_t* engine_evaluate_speech_binary(
+    EngineCoordinatorHandle handle,
+    const char* sentence,
+    const char* audio_file_path,
+    size_t* size);
+
+/**
+ * 비동기 음성 평가: 평가를 시작하고 바로 반환한다 (GetResults 폴링 불필요)
+ * on_complete는 문장 완료("completed"), 중지("stopped"), 취소("cancelled") 또는
+ * 시작 실패("busy", "initialization_failed", "start_failed") 중 처음 일어난 일로 정확히 한 번 호출된다.
+ * 시작 실패 시에는 이 함수 안에서, 그 외에는 엔진 내부 스레드에서 호출된다.
+ * 완료 후 세션 정리는 engine_stop_evaluation/engine_reset으로 한다 (콜백 안에서 호출 금지)
+ * @param handle 엔진 핸들
+ * @param sentence 평가할 문장
+ * @param audio_file_path 오디오 파일 경로
+ * @param on_complete 완료 콜백 (NULL 가능)
+ * @param user_data on_complete에 그대로 전달되는 포인터
+ * @return 평가가 시작되었는지 여부 (false여도 on_complete는 호출된다)
+ */
+bool engine_evaluate_speech_async(
+    EngineCoordinatorHandle handle,
+    const char* sentence,
+    const char* audio_file_path,
+    CompletionCallbackFn on_complete,
+    void* user_data);
+
+/**
+ * 진행 중인 비동기 평가 취소 (다음 틱에 "cancelled"로 완료)
+ * @param handle 엔진 핸들
+ */
+void engine_cancel_evaluation(EngineCoordinatorHandle handle);
+
+/**
+ * 단계별 지연 지표 (ingest, preprocess, inference, softmax, align, score, serialize, chunk)
+ * @param handle 엔진 핸들 (NULL이면 프로세스 전체 누적)
+ * @return JSON {"stages": {"<단계>": {"count", "sum_ms", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "max_ms"}}}
+ *         (메모리 해제 필요)
+ */
+const char* engine_get_metrics(EngineCoordinatorHandle handle);
+
+/**
+ * 단계별 지연 지표 (Prometheus 텍스트 형식, realtime_engine_stage_seconds 히스토그램)
+ * @param handle 엔진 핸들 (NULL이면 프로세스 전체 누적, scope 레이블 "process", 아니면 "session")
+ * @param session_label session 레이블 값 (여러 세션을 함께 수집할 때 구분용, NULL이나 ""이면 붙이지 않음)
+ * @return Prometheus 텍스트 (메모리 해제 필요)
+ */
+const char* engine_get_metrics_prometheus(EngineCoordinatorHandle handle, const char* session_label);
+
+/**
+ * 프로세스 공유 Reactor 설정: 이후 생성하는 엔진은 파일 감시/틱 스레드 대신 하나의 epoll 루프와 작업자 풀을 쓴다
+ * (이미 생성된 엔진은 영향 없음)
+ * @param num_threads 콜백 작업자 수 (0이면 하드웨어 스레드 수, 음수면 공유 Reactor 해제)
+ * @return 성공 시 1, 실패 시 0
+ */
+int engine_set_shared_reactor(int num_threads);
+
+/**
+ * 프로세스 전체 로그 레벨 하한 설정 (기본 1)
+ * @param level 0=DEBUG, 1=INFO, 2=WARNING, 3=ERROR (컴파일 시 하한보다 낮은 레벨은 설정해도 출력되지 않음)
+ */
+void engine_set_log_level(int level);
+
+/**
+ * 대기 중인 로그를 모두 출력할 때까지 대기 (종료 직전 등, 오디오/추론 스레드에서 호출 금지)
+ */
+void engine_flush_logs(void);
+
 /**
  * 엔진 인스턴스 제거
  * @param handle 엔진 핸들
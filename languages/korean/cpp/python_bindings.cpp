@@ -30,6 +30,54 @@ PYBIND11_MODULE(pyrealtime, m) {
         // 실제로 Python 함수가 들어올 때 std::function으로 자동 래핑됩니다.
         ;
 
+    //--- ScoreEventMode 바인딩 ---
+    py::enum_<realtime_engine_ko::ScoreEventMode>(m, "ScoreEventMode")
+        .value("FULL", realtime_engine_ko::ScoreEventMode::FULL)
+        .value("DELTA", realtime_engine_ko::ScoreEventMode::DELTA)
+        ;
+
+    //--- AlignmentMode 바인딩 ---
+    py::enum_<realtime_engine_ko::AlignmentMode>(m, "AlignmentMode")
+        .value("WINDOW", realtime_engine_ko::AlignmentMode::WINDOW)
+        .value("INCREMENTAL", realtime_engine_ko::AlignmentMode::INCREMENTAL)
+        ;
+
+    //--- 단계별 지연 지표 (프로세스 전체) ---
+    m.def("GetGlobalMetrics", []() {
+        return py::cast(json::parse(realtime_engine_ko::MetricsToJson(
+            realtime_engine_ko::StageMetrics::Global().GetSnapshot())));
+    });
+    m.def("GetGlobalMetricsPrometheus", []() {
+        return realtime_engine_ko::MetricsToPrometheus(
+            realtime_engine_ko::StageMetrics::Global().GetSnapshot(), "process");
+    });
+
+    //--- 로깅 ---
+    py::enum_<realtime_engine_ko::LogLevel>(m, "LogLevel")
+        .value("DEBUG", realtime_engine_ko::LogLevel::DEBUG)
+        .value("INFO", realtime_engine_ko::LogLevel::INFO)
+        .value("WARNING", realtime_engine_ko::LogLevel::WARNING)
+        .value("ERROR", realtime_engine_ko::LogLevel::ERROR);
+    m.def("SetLogLevel", &realtime_engine_ko::SetLogLevel, py::arg("level"));
+    m.def("GetLogLevel", &realtime_engine_ko::GetLogLevel);
+    m.def("FlushLogs", &realtime_engine_ko::FlushLogs, py::call_guard<py::gil_scoped_release>());
+
+    //--- Reactor 바인딩 (여러 세션의 파일 감시/틱을 하나의 이벤트 루프로) ---
+    py::class_<realtime_engine_ko::Reactor, std::shared_ptr<realtime_engine_ko::Reactor>>(m, "Reactor")
+        .def(py::init([](size_t num_threads, double watched_poll_interval) {
+            realtime_engine_ko::Reactor::Options options;
+            options.num_threads = num_threads;
+            options.watched_poll_interval = watched_poll_interval;
+            return std::make_shared<realtime_engine_ko::Reactor>(options);
+        }),
+        py::arg("num_threads") = 0,
+        py::arg("watched_poll_interval") = 1.0
+        )
+        .def("NumWorkers", &realtime_engine_ko::Reactor::NumWorkers);
+    // 이후 생성하는 EngineCoordinator의 기본 Reactor (None이면 해제)
+    m.def("SetSharedReactor", &realtime_engine_ko::Reactor::SetShared, py::arg("reactor"));
+    m.def("GetSharedReactor", &realtime_engine_ko::Reactor::Shared);
+
     //--- EngineCoordinator 바인딩 ---
     py::class_<realtime_engine_ko::EngineCoordinator>(m, "EngineCoordinator")
         .def(py::init<
@@ -45,6 +93,52 @@ PYBIND11_MODULE(pyrealtime, m) {
              py::arg("confidence_threshold") = 0.7f
         )
         .def("SetRecordListener", &realtime_engine_ko::EngineCoordinator::SetRecordListener)
+        .def("SetScoreEventMode", &realtime_engine_ko::EngineCoordinator::SetScoreEventMode,
+             py::arg("mode"))
+        .def("RequestSnapshot", &realtime_engine_ko::EngineCoordinator::RequestSnapshot)
+        .def("SetCandidateMargin", &realtime_engine_ko::EngineCoordinator::SetCandidateMargin,
+             py::arg("margin"))
+        .def("SetAlignmentMode", &realtime_engine_ko::EngineCoordinator::SetAlignmentMode,
+             py::arg("mode"))
+        .def("SetFrameStoreOptions", [](realtime_engine_ko::EngineCoordinator &self,
+                                         size_t max_bytes, bool store_hidden) {
+            realtime_engine_ko::FrameStore::Options options;
+            options.max_bytes = max_bytes;
+            options.store_hidden = store_hidden;
+            self.SetFrameStoreOptions(options);
+        },
+        py::arg("max_bytes"),
+        py::arg("store_hidden") = false
+        )
+        .def("SetReactor", &realtime_engine_ko::EngineCoordinator::SetReactor,
+             py::arg("reactor"))
+        .def("SetLongFormMode", &realtime_engine_ko::EngineCoordinator::SetLongFormMode,
+             py::arg("resident_blocks"),
+             py::arg("spill_path") = "")
+        // 보관된 구간 재채점 → {"overall", "pronunciation", "words": [{"word", "pronunciation"}]} 또는 None
+        .def("RescoreBlock", [](const realtime_engine_ko::EngineCoordinator &self,
+                                int block_id, double begin_seconds, double end_seconds) -> py::object {
+            auto result = self.RescoreBlock(block_id, begin_seconds, end_seconds);
+            if (!result) {
+                return py::none();
+            }
+            py::list words;
+            for (const auto& word : result->words) {
+                py::dict entry;
+                entry["word"] = word.word;
+                entry["pronunciation"] = word.pronunciation;
+                words.append(entry);
+            }
+            py::dict out;
+            out["overall"] = result->overall;
+            out["pronunciation"] = result->pronunciation;
+            out["words"] = words;
+            return std::move(out);
+        },
+        py::arg("block_id"),
+        py::arg("begin_seconds"),
+        py::arg("end_seconds")
+        )
         .def("Initialize", &realtime_engine_ko::EngineCoordinator::Initialize,
              py::arg("sentence"),
              py::arg("audio_polling_interval") = 0.03f,
@@ -55,12 +149,8 @@ PYBIND11_MODULE(pyrealtime, m) {
         .def("StopEvaluation", &realtime_engine_ko::EngineCoordinator::StopEvaluation)
         // C++ 의 std::map<string, any> 를 Python dict 로 바꾸려면 JSON 을 중간에 씁니다.
         .def("GetCurrentState", [](const realtime_engine_ko::EngineCoordinator &self) {
-            auto st = self.GetCurrentState();          // std::map<string, any>
-            json j = json::object();
-            for (auto &kv : st) {
-                // 가정: 모든 값이 string 으로 변환 가능하다면
-                j[kv.first] = std::any_cast<std::string>(kv.second);
-            }
+            // 중첩된 맵/벡터까지 타입을 유지한 채 변환
+            json j = realtime_engine_ko::ResultMapToJson(self.GetCurrentState());
             return py::cast(j);
         })
         .def("Reset", &realtime_engine_ko::EngineCoordinator::Reset)
@@ -69,15 +159,62 @@ PYBIND11_MODULE(pyrealtime, m) {
                                    const std::string &sent,
                                    const std::string &afile,
                                    const realtime_engine_ko::RecordListener &rl) {
-            auto st = self.EvaluateSpeech(sent, afile, rl);
-            json j = json::object();
-            for (auto &kv : st)
-                j[kv.first] = std::any_cast<std::string>(kv.second);
+            json j = realtime_engine_ko::ResultMapToJson(self.EvaluateSpeech(sent, afile, rl));
             return py::cast(j);
         },
         py::arg("sentence"),
         py::arg("audio_file_path"),
         py::arg("record_listener") = realtime_engine_ko::RecordListener()
         )
+        // EvaluateSpeechAsync → asyncio.Future (await하면 최종 상태 dict, Future를 취소하면 평가도 취소)
+        .def("EvaluateSpeechAsync", [](realtime_engine_ko::EngineCoordinator &self,
+                                        const std::string &sent,
+                                        const std::string &afile,
+                                        const realtime_engine_ko::RecordListener &rl) {
+            py::object loop = py::module_::import("asyncio").attr("get_event_loop")();
+            py::object future = loop.attr("create_future")();
+            auto cancel = std::make_shared<realtime_engine_ko::CancellationToken>();
+            future.attr("add_done_callback")(py::cpp_function([cancel](py::object done) {
+                if (done.attr("cancelled")().cast<bool>()) {
+                    cancel->Cancel();
+                }
+            }));
+
+            // 엔진 스레드에서 완료되므로 이벤트 루프 스레드로 넘겨 결과를 설정한다.
+            // Python 객체는 GIL을 잡고 해제해야 하므로 shared_ptr 삭제자에서 처리
+            py::object set_result = py::cpp_function([](py::object target, py::object value) {
+                if (!target.attr("done")().cast<bool>()) {
+                    target.attr("set_result")(value);
+                }
+            });
+            auto targets = std::shared_ptr<py::tuple>(
+                new py::tuple(py::make_tuple(loop, future, set_result)),
+                [](py::tuple* p) { py::gil_scoped_acquire gil; delete p; });
+
+            self.EvaluateSpeechAsync(sent, afile, rl,
+                [targets](const realtime_engine_ko::EngineState &state) {
+                    json j = realtime_engine_ko::ResultMapToJson(realtime_engine_ko::ToMap(state));
+                    py::gil_scoped_acquire gil;
+                    const py::tuple &t = *targets;
+                    t[0].attr("call_soon_threadsafe")(t[2], t[1], py::cast(j));
+                },
+                cancel);
+            return future;
+        },
+        py::arg("sentence"),
+        py::arg("audio_file_path"),
+        py::arg("record_listener") = realtime_engine_ko::RecordListener()
+        )
+        .def("CancelEvaluation", &realtime_engine_ko::EngineCoordinator::CancelEvaluation)
+        // 세션 단계별 지연 → {"stages": {"inference": {"count", "p50_ms", ...}, ...}}
+        .def("GetMetrics", [](const realtime_engine_ko::EngineCoordinator &self) {
+            return py::cast(json::parse(realtime_engine_ko::MetricsToJson(self.GetMetrics())));
+        })
+        // session: Prometheus session 레이블 (여러 세션을 함께 수집할 때 구분, 비우면 생략)
+        .def("GetMetricsPrometheus", [](const realtime_engine_ko::EngineCoordinator &self,
+                                        const std::string& session) {
+            return realtime_engine_ko::MetricsToPrometheus(self.GetMetrics(), "session", session);
+        },
+        py::arg("session") = "")
         ;
 }
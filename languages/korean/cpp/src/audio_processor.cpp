@@ -6,13 +6,16 @@
 #include <cmath>
 #include <chrono>
 #include <thread>
+#include <limits>
 
 namespace realtime_engine_ko {
 
 AudioProcessor::AudioProcessor(int sample_rate, float chunk_duration, float polling_interval)
     : sample_rate(sample_rate), chunk_duration(chunk_duration), polling_interval(polling_interval),
       audio_file_path(""), last_file_size(0), last_processed_pos(0), is_monitoring(false),
-      monitoring_thread(nullptr), total_duration(0.0) {
+      monitoring_thread(nullptr), total_duration(0.0), emitted_duration(0.0), vad(sample_rate),
+      total_chunks(0), silent_chunks(0), adaptive_chunking(false),
+      chunk_tolerance(0.5f), min_chunk_duration(1.0f), max_chunk_duration(3.0f) {
     
     std::stringstream ss;
     ss << "AudioProcessor 초기화: 샘플 레이트=" << sample_rate 
@@ -47,8 +50,15 @@ bool AudioProcessor::SetAudioFile(const std::string& file_path) {
         buffer.clear();
     }
     
-    // 최신 청크 초기화
+    // 입력 포맷에 맞는 리샘플러 준비 (sample_rate가 아니거나 다채널이면 변환)
+    resampler = std::make_unique<PolyphaseResampler>(sf_info.samplerate, sample_rate, sf_info.channels);
+    
+    // 최신 청크 및 VAD 상태 초기화
     latest_chunk.resize(0);
+    vad.Reset();
+    total_chunks = 0;
+    silent_chunks = 0;
+    emitted_duration = 0.0;
     
     std::stringstream ss;
     ss << "오디오 파일 설정: " << file_path << " (샘플 레이트=" << sf_info.samplerate 
@@ -95,47 +105,61 @@ void AudioProcessor::MonitoringLoop() {
     }
     
     while (is_monitoring) {
-        try {
-            // 파일 크기 확인
-            SF_INFO sf_info;
-            SNDFILE* file = sf_open(audio_file_path.c_str(), SFM_READ, &sf_info);
-            
-            if (!file) {
-                LOG_ERROR("AudioProcessor", "파일 크기 확인 중 오류 발생");
-                std::this_thread::sleep_for(std::chrono::milliseconds(
-                    static_cast<int>(polling_interval * 1000)));
-                continue;
-            }
-            
-            sf_count_t current_size = sf_info.frames;
-            sf_close(file);
-            
-            // 파일 크기가 증가했으면 새 데이터 처리
-            if (current_size > last_file_size) {
-                ProcessNewAudioData();
-                last_file_size = current_size;
-            }
-            
-            // 다음 확인까지 대기
-            std::this_thread::sleep_for(std::chrono::milliseconds(
-                static_cast<int>(polling_interval * 1000)));
-            
-        } catch (const std::exception& e) {
-            std::stringstream ss;
-            ss << "파일 모니터링 중 오류 발생: " << e.what();
-            LOG_ERROR("AudioProcessor", ss.str());
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(
-                static_cast<int>(polling_interval * 1000)));
+        PollFile();
+        
+        // 다음 확인까지 대기
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+            static_cast<int>(polling_interval * 1000)));
+    }
+}
+
+void AudioProcessor::PollFile() {
+    if (audio_file_path.empty()) {
+        return;
+    }
+    
+    StageMetrics::Scope metrics_scope(stage_metrics);
+    try {
+        // 파일 크기 확인
+        SF_INFO sf_info;
+        SNDFILE* file = sf_open(audio_file_path.c_str(), SFM_READ, &sf_info);
+        
+        if (!file) {
+            LOG_ERROR("AudioProcessor", "파일 크기 확인 중 오류 발생");
+            return;
         }
+        
+        sf_count_t current_size = sf_info.frames;
+        sf_close(file);
+        
+        // 파일 크기가 증가했으면 새 데이터 처리
+        if (current_size > last_file_size) {
+            ProcessNewAudioData();
+            last_file_size = current_size;
+        }
+        
+    } catch (const std::exception& e) {
+        std::stringstream ss;
+        ss << "파일 모니터링 중 오류 발생: " << e.what();
+        LOG_ERROR("AudioProcessor", ss.str());
     }
 }
 
 void AudioProcessor::ProcessNewAudioData() {
+    std::vector<float> mono_frames;
+    if (ReadNewAudioData(mono_frames)) {
+        AddToBuffer(mono_frames);
+    }
+}
+
+bool AudioProcessor::ReadNewAudioData(std::vector<float>& mono_frames) {
     if (audio_file_path.empty()) {
-        return;
+        return false;
     }
     
+    bool has_data = false;
+    ScopedStageTimer timer(Stage::INGEST);
+    
     try {
         // 파일 열기
         SF_INFO sf_info;
@@ -143,39 +167,35 @@ void AudioProcessor::ProcessNewAudioData() {
         
         if (!file) {
             LOG_ERROR("AudioProcessor", "새 오디오 데이터 처리 중 파일 열기 실패");
-            return;
+            return false;
         }
         
         // 마지막 처리 위치로 이동
         sf_seek(file, last_processed_pos, SEEK_SET);
         
+        // 입력 포맷이 바뀌었으면 리샘플러 재생성
+        if (!resampler || resampler->GetInputRate() != sf_info.samplerate ||
+            resampler->GetChannels() != sf_info.channels) {
+            resampler = std::make_unique<PolyphaseResampler>(sf_info.samplerate, sample_rate, sf_info.channels);
+        }
+        
         // 새 데이터 읽기
         sf_count_t frames_to_read = sf_info.frames - last_processed_pos;
-        std::vector<float> frames(frames_to_read * sf_info.channels);
+        if (frames_to_read <= 0) {
+            sf_close(file);
+            return false;
+        }
+        read_buffer.resize(frames_to_read * sf_info.channels);
         
-        sf_count_t frames_read = sf_readf_float(file, frames.data(), frames_to_read);
+        sf_count_t frames_read = sf_readf_float(file, read_buffer.data(), frames_to_read);
         
         if (frames_read > 0) {
-            // 스테레오를 모노로 변환
-            std::vector<float> mono_frames;
-            if (sf_info.channels > 1) {
-                mono_frames.resize(frames_read);
-                for (sf_count_t i = 0; i < frames_read; ++i) {
-                    float sum = 0.0f;
-                    for (int ch = 0; ch < sf_info.channels; ++ch) {
-                        sum += frames[i * sf_info.channels + ch];
-                    }
-                    mono_frames[i] = sum / static_cast<float>(sf_info.channels);
-                }
-            } else {
-                mono_frames = frames;
-            }
-            
-            // 새 데이터 처리
-            AddToBuffer(mono_frames);
+            // 다운믹스 + 리샘플링 (필터 상태는 읽기 사이에 유지)
+            resampler->Process(read_buffer.data(), static_cast<size_t>(frames_read), mono_frames);
             
             // 처리 위치 업데이트
             last_processed_pos += frames_read;
+            has_data = !mono_frames.empty();
         }
         
         sf_close(file);
@@ -185,9 +205,11 @@ void AudioProcessor::ProcessNewAudioData() {
         ss << "새 오디오 데이터 처리 중 오류 발생: " << e.what();
         LOG_ERROR("AudioProcessor", ss.str());
     }
+    
+    return has_data;
 }
 
-void AudioProcessor::AddToBuffer(const std::vector<float>& audio_data) {
+void AudioProcessor::AddToBuffer(const std::vector<float>& audio_data, bool process_chunks) {
     if (audio_data.empty()) {
         return;
     }
@@ -208,173 +230,357 @@ void AudioProcessor::AddToBuffer(const std::vector<float>& audio_data) {
     // 버퍼에 추가
     {
         std::lock_guard<std::mutex> lock(buffer_mutex);
-        buffer.push_back(std::move(normalized_data));
+        buffer.insert(buffer.end(), normalized_data.begin(), normalized_data.end());
     }
     
     // 총 녹음 시간 업데이트
     total_duration += static_cast<float>(audio_data.size()) / static_cast<float>(sample_rate);
     
     // 새 청크 생성 가능한지 확인
-    CheckAndProcessChunks();
+    if (process_chunks) {
+        CheckAndProcessChunks();
+    }
 }
 
-void AudioProcessor::CheckAndProcessChunks() {
-    // 청크 단위 샘플 수 계산
-    int chunk_samples = static_cast<int>(chunk_duration * sample_rate);
+void AudioProcessor::CheckAndProcessChunks(bool flush) {
+    // 버퍼에 잘라낼 수 있는 청크가 남아 있는 동안 반복
+    while (true) {
+        int chunk_samples = FindChunkLength(flush);
+        if (chunk_samples <= 0) {
+            return;
+        }
+        
+        // 청크 추출
+        AudioTensor chunk = ExtractChunk(chunk_samples);
+        
+        // 청크가 비어있으면 종료
+        if (chunk.size() == 0) {
+            return;
+        }
+        
+        EmitChunk(chunk);
+    }
+}
+
+void AudioProcessor::EmitChunk(const AudioTensor& chunk) {
+    total_chunks++;
     
-    // 청크 추출
-    AudioTensor chunk = ExtractChunk(chunk_samples);
+    // 세션 시간축 (건너뛴 무음 청크도 시간은 흐른다)
+    const double start_time = emitted_duration;
+    emitted_duration += static_cast<double>(chunk.size()) / sample_rate;
     
-    // 청크가 비어있으면 종료
-    if (chunk.size() == 0) {
+    // 청크 전처리 (VAD 게이트 + 정규화) - 무음 청크는 추론 없이 건너뛴다
+    AudioTensor processed;
+    {
+        ScopedStageTimer timer(Stage::PREPROCESS);
+        processed = PreprocessChunk(chunk);
+    }
+    if (processed.size() == 0) {
+        silent_chunks++;
         return;
     }
     
-    // 청크 전처리 및 저장
-    latest_chunk = chunk;
+    latest_chunk = std::move(processed);
     
     // 청크 타임스탬프 업데이트
     last_chunk_time = std::chrono::system_clock::now();
     
     // 청크 생성 후 콜백 호출
-    if (latest_chunk.size() > 0) {
-        MetadataMap metadata;
-        metadata["timestamp"] = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-        metadata["duration"] = chunk_duration;
-        metadata["total_duration"] = total_duration;
-        
-        for (const auto& callback : chunk_callbacks) {
-            if (callback) {
-                callback(latest_chunk, metadata);
-            }
+    MetadataMap metadata;
+    metadata["timestamp"] = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    metadata["duration"] = static_cast<float>(chunk.size()) / static_cast<float>(sample_rate);
+    metadata["total_duration"] = total_duration;
+    metadata["start_time"] = start_time;  // double, 세션 시작부터 내보낸 오디오 기준 (초)
+    
+    for (const auto& callback : chunk_callbacks) {
+        if (callback) {
+            callback(latest_chunk, metadata);
         }
     }
 }
 
-AudioProcessor::AudioTensor AudioProcessor::ExtractChunk(int chunk_samples) {
-    std::lock_guard<std::mutex> lock(buffer_mutex);
-    
-    std::vector<float> result;
-    result.reserve(chunk_samples);
+void AudioProcessor::Flush() {
+    // 남은 오디오를 최대 길이 제한 내에서 모두 청크로 내보낸다
+    CheckAndProcessChunks(true);
+}
+
+bool AudioProcessor::ProcessFile(const std::string& file_path, bool chunked) {
+    if (is_monitoring) {
+        LOG_WARNING("AudioProcessor", "모니터링 중에는 파일 전체 처리를 할 수 없습니다.");
+        return false;
+    }
     
-    int samples_collected = 0;
+    if (!SetAudioFile(file_path)) {
+        return false;
+    }
     
-    while (samples_collected < chunk_samples && !buffer.empty()) {
-        auto& buffer_data = buffer.front();
-        int samples_needed = chunk_samples - samples_collected;
-        
-        if (static_cast<int>(buffer_data.size()) <= samples_needed) {
-            // 버퍼 데이터 전체 사용
-            result.insert(result.end(), buffer_data.begin(), buffer_data.end());
-            samples_collected += buffer_data.size();
-            buffer.erase(buffer.begin());
-        } else {
-            // 버퍼 데이터 일부만 사용
-            result.insert(result.end(), buffer_data.begin(), buffer_data.begin() + samples_needed);
-            buffer_data.erase(buffer_data.begin(), buffer_data.begin() + samples_needed);
-            samples_collected += samples_needed;
+    // 파일 전체를 한 번에 읽어 호출 스레드에서 동기적으로 콜백 실행
+    std::vector<float> mono_frames;
+    ReadNewAudioData(mono_frames);
+    
+    if (chunked) {
+        AddToBuffer(mono_frames);
+        Flush();
+    } else {
+        AddToBuffer(mono_frames, false);
+        AudioTensor chunk = ExtractChunk(std::numeric_limits<int>::max());
+        if (chunk.size() > 0) {
+            EmitChunk(chunk);
         }
     }
     
-    // 빈 청크인 경우 그대로 반환
-    if (result.empty()) {
-        return AudioTensor();
+    std::stringstream ss;
+    ss << "오디오 파일 전체 처리 완료: " << file_path << " (" << total_duration << "초, "
+       << total_chunks << " 청크, 무음 " << silent_chunks << ")";
+    LOG_INFO("AudioProcessor", ss.str());
+    
+    return true;
+}
+
+void AudioProcessor::StartStream(int input_sample_rate, int channels) {
+    StopMonitoring();
+    
+    audio_file_path = "";
+    last_file_size = 0;
+    last_processed_pos = 0;
+    total_duration = 0.0;
+    
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex);
+        buffer.clear();
     }
     
-    // 결과를 AudioTensor로 변환
-    AudioTensor tensor(result.size());
-    for (size_t i = 0; i < result.size(); ++i) {
-        tensor(i) = result[i];
+    resampler = std::make_unique<PolyphaseResampler>(input_sample_rate, sample_rate, channels);
+    latest_chunk.resize(0);
+    vad.Reset();
+    total_chunks = 0;
+    silent_chunks = 0;
+    emitted_duration = 0.0;
+    
+    std::stringstream ss;
+    ss << "스트리밍 입력 시작 (샘플 레이트=" << input_sample_rate << "Hz, 채널=" << channels << ")";
+    LOG_INFO("AudioProcessor", ss.str());
+}
+
+void AudioProcessor::PushAudio(const float* interleaved, size_t frames) {
+    if (!resampler || frames == 0) {
+        return;
     }
     
-    return tensor;
+    {
+        ScopedStageTimer timer(Stage::INGEST);
+        stream_buffer.clear();
+        resampler->Process(interleaved, frames, stream_buffer);
+    }
+    AddToBuffer(stream_buffer);
 }
 
-AudioProcessor::AudioTensor AudioProcessor::PreprocessChunk(const std::vector<float>& chunk, bool do_normalize) {
-    // VAD 검사 - 음성이 없으면 빈 텐서 반환
-    if (!DetectVoiceActivity(chunk)) {
-        return AudioTensor();
+bool AudioProcessor::LoadFile(const std::string& file_path, AudioTensor& audio) {
+    if (is_monitoring) {
+        LOG_WARNING("AudioProcessor", "모니터링 중에는 파일 전체를 읽을 수 없습니다.");
+        return false;
     }
     
-    // 1) 정규화
-    std::vector<float> processed = chunk;
-    if (do_normalize) {
-        // 평균 및 표준편차 계산
-        float mean = 0.0f;
-        for (float sample : chunk) {
-            mean += sample;
-        }
-        mean /= chunk.size();
-        
-        float stddev = 0.0f;
-        for (float sample : chunk) {
-            stddev += (sample - mean) * (sample - mean);
-        }
-        stddev = std::sqrt(stddev / chunk.size());
-        
-        // 정규화 적용
-        for (size_t i = 0; i < processed.size(); ++i) {
-            processed[i] = (processed[i] - mean) / (stddev + 1e-8f);
-        }
+    if (!SetAudioFile(file_path)) {
+        return false;
     }
     
-    // 2) AudioTensor로 변환
-    AudioTensor tensor(processed.size());
-    for (size_t i = 0; i < processed.size(); ++i) {
-        tensor(i) = processed[i];
+    std::vector<float> mono_frames;
+    ReadNewAudioData(mono_frames);
+    
+    // AddToBuffer와 같은 피크 정규화
+    audio = Eigen::Map<const AudioTensor>(mono_frames.data(), static_cast<Eigen::Index>(mono_frames.size()));
+    float max_abs = audio.size() > 0 ? audio.cwiseAbs().maxCoeff() : 0.0f;
+    if (max_abs > 1.0f) {
+        audio /= max_abs;
     }
+    total_duration = static_cast<float>(audio.size()) / static_cast<float>(sample_rate);
     
-    return tensor;
+    return true;
 }
 
-bool AudioProcessor::DetectVoiceActivity(const std::vector<float>& audio_data, 
-                                        float energy_threshold, int min_speech_frames) {
-    // 프레임 단위로 분할 (10ms 프레임)
-    int frame_size = static_cast<int>(sample_rate * 0.01);
-    std::vector<std::vector<float>> frames;
-    
-    for (size_t i = 0; i < audio_data.size(); i += frame_size) {
-        size_t end = std::min(i + frame_size, audio_data.size());
-        if (end - i == frame_size) {  // 완전한 프레임만 고려
-            frames.push_back(std::vector<float>(audio_data.begin() + i, audio_data.begin() + end));
+std::vector<AudioProcessor::AudioTensor> AudioProcessor::SplitAtPauses(
+    const AudioTensor& audio, float min_pause, float min_segment, float max_segment) const {
+    
+    std::vector<AudioTensor> segments;
+    
+    Eigen::VectorXf energies;
+    Eigen::VectorXf zero_crossing_rates;
+    vad.ComputeFrameFeatures(audio.data(), static_cast<size_t>(audio.size()), energies, zero_crossing_rates);
+    
+    const int num_frames = static_cast<int>(energies.size());
+    if (num_frames == 0) {
+        return segments;
+    }
+    
+    const int frame_size = vad.GetFrameSize();
+    const float threshold = vad.GetEnergyThreshold();
+    const float frames_per_second = static_cast<float>(sample_rate) / frame_size;
+    const int min_pause_frames = std::max(1, static_cast<int>(std::lround(min_pause * frames_per_second)));
+    const int min_segment_frames = std::max(1, static_cast<int>(std::lround(min_segment * frames_per_second)));
+    const int max_segment_frames = std::max(min_segment_frames + 1,
+                                            static_cast<int>(std::lround(max_segment * frames_per_second)));
+    
+    // 충분히 긴 무음 구간의 가운데 프레임을 분할 후보로 수집
+    std::vector<int> pause_cuts;
+    int run_start = -1;
+    for (int i = 0; i <= num_frames; ++i) {
+        bool silent = i < num_frames && energies(i) <= threshold;
+        if (silent) {
+            if (run_start < 0) {
+                run_start = i;
+            }
+        } else if (run_start >= 0) {
+            if (i - run_start >= min_pause_frames) {
+                pause_cuts.push_back((run_start + i) / 2);
+            }
+            run_start = -1;
         }
     }
     
-    // 각 프레임의 에너지 계산
-    std::vector<float> energies;
-    for (const auto& frame : frames) {
-        float energy = 0.0f;
-        for (float sample : frame) {
-            energy += sample * sample;
+    auto emit = [&](int begin_frame, int end_frame) {
+        // 음성 프레임이 하나도 없으면 추론할 필요가 없다
+        if (!(energies.segment(begin_frame, end_frame - begin_frame).array() > threshold).any()) {
+            return;
+        }
+        Eigen::Index begin = static_cast<Eigen::Index>(begin_frame) * frame_size;
+        Eigen::Index end = end_frame == num_frames ? audio.size()
+                                                   : static_cast<Eigen::Index>(end_frame) * frame_size;
+        segments.push_back(NormalizeChunk(audio.segment(begin, end - begin)));
+    };
+    
+    int start = 0;
+    // 무음 없이 max_segment를 넘는 구간은 허용 범위 내 최소 에너지 프레임에서 강제로 자른다
+    auto force_cuts_until = [&](int limit) {
+        while (limit - start > max_segment_frames) {
+            Eigen::Index offset;
+            energies.segment(start + min_segment_frames, max_segment_frames - min_segment_frames).minCoeff(&offset);
+            int cut = start + min_segment_frames + static_cast<int>(offset);
+            emit(start, cut);
+            start = cut;
+        }
+    };
+    
+    for (int cut : pause_cuts) {
+        force_cuts_until(cut);
+        if (cut - start >= min_segment_frames) {
+            emit(start, cut);
+            start = cut;
         }
-        energy /= frame.size();
-        energies.push_back(energy);
     }
+    force_cuts_until(num_frames);
+    if (start < num_frames) {
+        emit(start, num_frames);
+    }
+    
+    std::stringstream ss;
+    ss << "무음 기준 분할: " << static_cast<float>(audio.size()) / sample_rate << "초 → "
+       << segments.size() << " 세그먼트";
+    LOG_INFO("AudioProcessor", ss.str());
+    
+    return segments;
+}
+
+int AudioProcessor::FindChunkLength(bool flush) const {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    
+    int available = static_cast<int>(buffer.size());
+    int target = static_cast<int>(chunk_duration * sample_rate);
     
-    // 임계값을 넘는 프레임 수 계산
-    int speech_frames = 0;
-    for (float energy : energies) {
-        if (energy > energy_threshold) {
-            speech_frames++;
+    if (!adaptive_chunking) {
+        if (available >= target) {
+            return target;
         }
+        return flush ? available : 0;
     }
     
-    // 로깅 (디버깅용)
-    float avg_energy = 0.0f;
-    if (!energies.empty()) {
-        for (float energy : energies) {
-            avg_energy += energy;
+    int min_samples = static_cast<int>(min_chunk_duration * sample_rate);
+    int max_samples = static_cast<int>(max_chunk_duration * sample_rate);
+    int search_begin = std::max(min_samples, target - static_cast<int>(chunk_tolerance * sample_rate));
+    int search_end = std::min(max_samples, target + static_cast<int>(chunk_tolerance * sample_rate));
+    
+    // 탐색 창 전체(또는 최대 길이)가 버퍼에 들어올 때까지 대기
+    if (available < search_end) {
+        return flush ? available : 0;
+    }
+    if (search_end <= search_begin) {
+        return std::min(target, max_samples);
+    }
+    
+    // 탐색 창 내 10ms 프레임 에너지 계산 후 국소 최소 에너지 지점에서 자른다
+    Eigen::VectorXf energies;
+    Eigen::VectorXf zero_crossing_rates;
+    vad.ComputeFrameFeatures(buffer.data() + search_begin, search_end - search_begin,
+                             energies, zero_crossing_rates);
+    if (energies.size() == 0) {
+        return target;
+    }
+    
+    // 에너지가 같다면 목표 길이에 가까운 지점을 선호
+    int frame_size = vad.GetFrameSize();
+    int best_cut = target;
+    float best_cost = std::numeric_limits<float>::infinity();
+    for (Eigen::Index i = 0; i < energies.size(); ++i) {
+        int cut = search_begin + static_cast<int>(i) * frame_size + frame_size / 2;
+        float distance = std::abs(cut - target) / static_cast<float>(search_end - search_begin);
+        float cost = energies(i) * (1.0f + distance);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_cut = cut;
         }
-        avg_energy /= energies.size();
     }
     
+    return best_cut;
+}
+
+AudioProcessor::AudioTensor AudioProcessor::ExtractChunk(int chunk_samples) {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    
+    int samples = std::min(chunk_samples, static_cast<int>(buffer.size()));
+    
+    // 빈 청크인 경우 그대로 반환
+    if (samples <= 0) {
+        return AudioTensor();
+    }
+    
+    // 결과를 AudioTensor로 변환 후 버퍼 앞부분 제거
+    AudioTensor tensor = Eigen::Map<const AudioTensor>(buffer.data(), samples);
+    buffer.erase(buffer.begin(), buffer.begin() + samples);
+    
+    return tensor;
+}
+
+void AudioProcessor::SetAdaptiveChunking(bool enabled, float tolerance, float min_duration, float max_duration) {
+    adaptive_chunking = enabled;
+    chunk_tolerance = std::max(0.0f, tolerance);
+    min_chunk_duration = std::max(0.0f, min_duration);
+    max_chunk_duration = std::max(min_chunk_duration, max_duration);
+    
     std::stringstream ss;
-    ss << "VAD: 평균 에너지=" << avg_energy << ", 음성 프레임=" 
-       << speech_frames << "/" << energies.size();
-    LOG_DEBUG("AudioProcessor", ss.str());
+    ss << "적응형 청크 분할 " << (enabled ? "활성화" : "비활성화") << ": 허용 범위=±" << chunk_tolerance
+       << "초, 최소=" << min_chunk_duration << "초, 최대=" << max_chunk_duration << "초";
+    LOG_INFO("AudioProcessor", ss.str());
+}
+
+AudioProcessor::AudioTensor AudioProcessor::PreprocessChunk(const AudioTensor& chunk, bool do_normalize) {
+    // VAD 검사 - 음성이 없으면 빈 텐서 반환 (hangover 상태는 청크 사이에 유지됨)
+    if (!vad.ProcessChunk(chunk.data(), static_cast<size_t>(chunk.size()))) {
+        return AudioTensor();
+    }
+    
+    if (!do_normalize) {
+        return chunk;
+    }
+    
+    return NormalizeChunk(chunk);
+}
+
+AudioProcessor::AudioTensor AudioProcessor::NormalizeChunk(const AudioTensor& chunk) {
+    // 평균 및 표준편차로 정규화
+    float mean = chunk.mean();
+    float stddev = std::sqrt((chunk.array() - mean).square().mean());
     
-    // 임계값을 넘는 프레임이 충분한지 확인
-    return speech_frames >= min_speech_frames;
+    return ((chunk.array() - mean) / (stddev + 1e-8f)).matrix();
 }
 
 std::pair<AudioProcessor::AudioTensor, std::map<std::string, std::any>> AudioProcessor::GetLatestChunk() const {
@@ -405,6 +611,11 @@ void AudioProcessor::Reset() {
     
     total_duration = 0.0;
     latest_chunk.resize(0);
+    resampler.reset();
+    vad.Reset();
+    total_chunks = 0;
+    silent_chunks = 0;
+    emitted_duration = 0.0;
     
     LOG_INFO("AudioProcessor", "상태 초기화 완료");
 }
@@ -2,32 +2,291 @@
 #include "realtime_engine_ko/common.h"
 #include <iostream>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
 
 namespace realtime_engine_ko {
 
-// 로깅 유틸리티 구현
-void Logger(LogLevel level, const std::string& component, const std::string& message) {
-    // 현재 시간 가져오기
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    
-    // 시간 포맷팅
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    
-    // 로그 레벨 문자열
-    std::string level_str;
+namespace detail {
+std::atomic<int> log_threshold{static_cast<int>(LogLevel::INFO)};
+} // namespace detail
+
+namespace {
+
+constexpr size_t kLogQueueCapacity = 8192;  // 2의 거듭제곱
+constexpr auto kWriterIdleWait = std::chrono::milliseconds(50);
+
+const char* LevelName(LogLevel level) {
     switch (level) {
-        case LogLevel::DEBUG:   level_str = "DEBUG"; break;
-        case LogLevel::INFO:    level_str = "INFO"; break;
-        case LogLevel::WARNING: level_str = "WARNING"; break;
-        case LogLevel::ERROR:   level_str = "ERROR"; break;
-    }
-    
-    // 로그 메시지 출력
-    std::cout << ss.str() << " - " << component << " - " << level_str << " - " << message << std::endl;
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR:   return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+// 로그 한 줄 포맷 (localtime 대신 스레드 안전한 localtime_r, 같은 초는 이전 결과 재사용)
+class LineFormatter {
+public:
+    void Append(std::string& out, LogLevel level, std::chrono::system_clock::time_point time,
+                const std::string& component, const std::string& message) {
+        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+        if (seconds != cached_seconds) {
+            std::tm local{};
+            localtime_r(&seconds, &local);
+            cached_length = std::strftime(cached_time, sizeof(cached_time), "%Y-%m-%d %H:%M:%S", &local);
+            cached_seconds = seconds;
+        }
+        out.append(cached_time, cached_length);
+        out += " - ";
+        out += component;
+        out += " - ";
+        out += LevelName(level);
+        out += " - ";
+        out += message;
+        out += '\n';
+    }
+
+private:
+    std::time_t cached_seconds = -1;
+    char cached_time[32] = {};
+    size_t cached_length = 0;
+};
+
+// 제한 크기 잠금 없는 링 버퍼 (Vyukov 방식, 생산자 여럿/소비자는 기록 스레드 하나).
+// 생산자는 슬롯 하나를 CAS로 예약해 채우기만 하며, 가득 차면 기다리지 않고 실패한다
+class LogQueue {
+public:
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time;
+        std::string component;
+        std::string message;
+    };
+
+    LogQueue() {
+        for (size_t i = 0; i < kLogQueueCapacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer = std::thread(&LogQueue::WriterLoop, this);
+        writer_id = writer.get_id();
+    }
+
+    // 종료 후(atexit 이후)에는 false: 호출자가 직접 출력한다
+    bool Push(LogLevel level, const std::string& component, std::string&& message) {
+        if (stopped.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & kMask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return true;  // 가득 참: 버리고 기록 스레드가 건수를 남긴다
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->record.level = level;
+        slot->record.time = std::chrono::system_clock::now();
+        slot->record.component = component;
+        slot->record.message = std::move(message);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        enqueued.fetch_add(1, std::memory_order_release);
+
+        // 기록 스레드가 잠들어 있을 때만 깨운다 (놓친 알림은 대기 시간 제한으로 회수된다)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer_idle.load(std::memory_order_relaxed)) {
+            wake_cv.notify_one();
+        }
+        return true;
+    }
+
+    void Flush() {
+        if (stopped.load(std::memory_order_acquire) || std::this_thread::get_id() == writer_id) {
+            return;
+        }
+        uint64_t target = enqueued.load(std::memory_order_acquire);
+        wake_cv.notify_one();
+
+        std::unique_lock<std::mutex> lock(flush_mutex);
+        flush_cv.wait(lock, [&]() {
+            return written.load(std::memory_order_acquire) >= target || stopped.load(std::memory_order_acquire);
+        });
+    }
+
+    // 남은 로그를 모두 쓰고 기록 스레드를 끝낸다
+    void Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake_cv.notify_one();
+        if (writer.joinable()) {
+            writer.join();
+        }
+    }
+
+private:
+    static constexpr size_t kMask = kLogQueueCapacity - 1;
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+
+    bool Pop(Record& out) {
+        Slot& slot = slots[dequeue_pos & kMask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeue_pos + 1) < 0) {
+            return false;
+        }
+        out.level = slot.record.level;
+        out.time = slot.record.time;
+        out.component.swap(slot.record.component);
+        out.message.swap(slot.record.message);
+        slot.sequence.store(dequeue_pos + kLogQueueCapacity, std::memory_order_release);
+        ++dequeue_pos;
+        return true;
+    }
+
+    bool Empty() const {
+        const Slot& slot = slots[dequeue_pos & kMask];
+        return slot.sequence.load(std::memory_order_acquire) != dequeue_pos + 1;
+    }
+
+    // 큐에 쌓인 로그를 한 번에 포맷해 쓰고 배치당 한 번만 flush한다
+    void WriteBatch() {
+        std::string batch;
+        Record record;
+        uint64_t count = 0;
+
+        uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) {
+            formatter.Append(batch, LogLevel::WARNING, std::chrono::system_clock::now(), "Logger",
+                             "로그 큐가 가득 차 " + std::to_string(lost) + "건을 버림");
+        }
+        while (Pop(record)) {
+            formatter.Append(batch, record.level, record.time, record.component, record.message);
+            ++count;
+        }
+
+        if (!batch.empty()) {
+            std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            std::cout.flush();
+        }
+        if (count > 0) {
+            std::lock_guard<std::mutex> lock(flush_mutex);
+            written.fetch_add(count, std::memory_order_release);
+        }
+        flush_cv.notify_all();
+    }
+
+    void WriterLoop() {
+        for (;;) {
+            WriteBatch();
+
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            if (stopping) {
+                break;
+            }
+            writer_idle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Empty() && dropped.load(std::memory_order_relaxed) == 0) {
+                wake_cv.wait_for(lock, kWriterIdleWait);
+            }
+            writer_idle.store(false, std::memory_order_relaxed);
+        }
+
+        // 종료: 이후 Push는 직접 출력으로 돌리고, 그 전에 들어온 로그를 마저 쓴다
+        stopped.store(true, std::memory_order_release);
+        WriteBatch();
+        {
+            std::lock_guard<std::mutex> lock(flush_mutex);
+        }
+        flush_cv.notify_all();
+    }
+
+    Slot slots[kLogQueueCapacity];
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) size_t dequeue_pos = 0;  // 기록 스레드 전용
+    LineFormatter formatter;              // 기록 스레드 전용
+
+    std::atomic<uint64_t> enqueued{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool> writer_idle{false};
+    bool stopping = false;  // wake_mutex 보호
+    std::atomic<bool> stopped{false};
+
+    std::mutex flush_mutex;
+    std::condition_variable flush_cv;
+
+    std::thread writer;
+    std::thread::id writer_id;
+};
+
+// 종료 중 다른 스레드가 로그를 남겨도 안전하도록 해제하지 않는다 (atexit에서 기록 스레드만 정리)
+LogQueue& Queue() {
+    static LogQueue* queue = []() {
+        auto* created = new LogQueue();
+        std::atexit([]() { Queue().Shutdown(); });
+        return created;
+    }();
+    return *queue;
+}
+
+// 기록 스레드 종료 후의 직접 출력
+void WriteDirect(LogLevel level, const std::string& component, const std::string& message) {
+    static std::mutex direct_mutex;
+    std::string line;
+    LineFormatter formatter;
+    formatter.Append(line, level, std::chrono::system_clock::now(), component, message);
+
+    std::lock_guard<std::mutex> lock(direct_mutex);
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
+}
+
+} // namespace
+
+// 로깅 유틸리티 구현
+void SetLogLevel(LogLevel level) {
+    detail::log_threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel GetLogLevel() {
+    return static_cast<LogLevel>(detail::log_threshold.load(std::memory_order_relaxed));
+}
+
+void Logger(LogLevel level, const std::string& component, std::string message) {
+    if (!LogEnabled(level)) {
+        return;
+    }
+    if (!Queue().Push(level, component, std::move(message))) {
+        WriteDirect(level, component, message);
+    }
+}
+
+void FlushLogs() {
+    Queue().Flush();
 }
 
-} // namespace realtime_engine_ko
\ No newline at end of file
+} // namespace realtime_engine_ko
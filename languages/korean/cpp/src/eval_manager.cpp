@@ -11,19 +11,23 @@ EvaluationController::EvaluationController(
     std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
     std::shared_ptr<SentenceBlockManager> sentence_manager,
     std::shared_ptr<ProgressTracker> progress_tracker,
+    std::shared_ptr<const SentencePlan> plan,
     float confidence_threshold,
-    float min_time_between_evals)
+    float min_time_between_evals,
+    float candidate_margin)
     : recognition_engine(recognition_engine),
       sentence_manager(sentence_manager),
       progress_tracker(progress_tracker),
+      plan(std::move(plan)),
       confidence_threshold(confidence_threshold),
       min_time_between_evals(min_time_between_evals),
+      candidate_margin(candidate_margin),
       last_eval_time(std::nullopt) {
     
     LOG_INFO("EvaluationController", "EvaluationController 초기화 완료");
 }
 
-std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
+EvaluationResult EvaluationController::ProcessRecognitionResult(
     const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_chunk,
     const std::map<std::string, std::any>& metadata) {
     
@@ -35,9 +39,34 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
         return CreateResultFormat();
     }
     
-    // 활성 윈도우 내 모든 블록에 대해 매칭 시도
-    int best_match_id = -1;
-    float best_match_score = -std::numeric_limits<float>::infinity();
+    // 인코더는 청크당 한 번만 실행하고 윈도우 내 블록들이 출력을 공유한다
+    Wav2VecCTCOnnxCore::EncoderOutput output;
+    try {
+        output = recognition_engine->RunEncoder(audio_chunk);
+    } catch (const std::exception& e) {
+        std::stringstream ss;
+        ss << "인코더 실행 중 오류: " << e.what();
+        LOG_ERROR("EvaluationController", ss.str());
+        return CreateResultFormat();
+    }
+    
+    if (frame_store) {
+        // 이 청크 앞에서 무음으로 건너뛰었거나 버린 청크만큼 시간축을 맞춘다
+        auto start_time = metadata.find("start_time");
+        if (start_time != metadata.end()) {
+            frame_store->SkipTo(std::any_cast<double>(start_time->second));
+        }
+        frame_store->Append(output, static_cast<double>(audio_chunk.size()) / Wav2VecCTCOnnxCore::kSampleRate);
+    }
+    
+    if (aligner) {
+        return ProcessIncremental(output);
+    }
+    
+    // 1단계: 정렬 없이 CTC 사후 확률만으로 윈도우 내 후보 블록 순위 매기기
+    std::vector<std::pair<int, float>> candidates;
+    candidates.reserve(active_window.size());
+    float best_spot_score = -std::numeric_limits<float>::infinity();
     
     for (int block_id : active_window) {
         auto block = sentence_manager->GetBlock(block_id);
@@ -50,59 +79,28 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
             continue;
         }
         
-        // 현재 블록의 컨텍스트 수집
-        std::string context_before = "";
-        std::string context_after = "";
-        
-        // 이전 블록들을 context_before로 수집 (최대 2개)
-        std::vector<std::string> prev_blocks;
-        for (int i = std::max(0, block_id - 2); i < block_id; ++i) {
-            auto prev_block = sentence_manager->GetBlock(i);
-            if (prev_block) {
-                prev_blocks.push_back(prev_block->text);
-            }
-        }
-        
-        if (!prev_blocks.empty()) {
-            for (size_t i = 0; i < prev_blocks.size(); ++i) {
-                context_before += prev_blocks[i];
-                if (i < prev_blocks.size() - 1) {
-                    context_before += " ";
-                }
-            }
-        }
-        
-        // 다음 블록들을 context_after로 수집 (최대 2개)
-        std::vector<std::string> next_blocks;
-        for (int i = block_id + 1; i < std::min(block_id + 3, static_cast<int>(sentence_manager->blocks.size())); ++i) {
-            auto next_block = sentence_manager->GetBlock(i);
-            if (next_block) {
-                next_blocks.push_back(next_block->text);
-            }
-        }
-        
-        if (!next_blocks.empty()) {
-            for (size_t i = 0; i < next_blocks.size(); ++i) {
-                context_after += next_blocks[i];
-                if (i < next_blocks.size() - 1) {
-                    context_after += " ";
-                }
-            }
+        float spot_score = recognition_engine->SpotTokens(output, plan->blocks[block_id].target_tokens);
+        best_spot_score = std::max(best_spot_score, spot_score);
+        candidates.emplace_back(block_id, spot_score);
+    }
+    
+    // 2단계: 최고 후보와 margin 이내인 블록만 전체 정렬/GOP 계산
+    int best_match_id = -1;
+    float best_match_score = -std::numeric_limits<float>::infinity();
+    int skipped = 0;
+    
+    for (const auto& [block_id, spot_score] : candidates) {
+        if (candidate_margin >= 0.0f && spot_score < best_spot_score - candidate_margin) {
+            skipped++;
+            continue;
         }
         
-        // 블록 텍스트로 GOP 계산 (컨텍스트 포함)
+        // 블록 GOP 계산 (컨텍스트 토큰은 Initialize에서 미리 컴파일됨)
         try {
-            auto gop_result = recognition_engine->CalculateGopWithContext(
-                audio_chunk,
-                block->text,
-                context_before,
-                context_after,
-                // 컨텍스트 내 위치는 항상 0 (단독 블록 평가 시)
-                context_before.empty() ? std::optional<int>(0) : std::nullopt
-            );
+            auto gop_result = recognition_engine->ScoreBlock(output, plan->blocks[block_id]);
             
             // 전체 발음 점수 추출
-            float overall_score = std::any_cast<float>(gop_result["overall"]);
+            float overall_score = gop_result.overall;
             
             // 현재 블록이 최적 매치인지 확인
             if (overall_score > best_match_score) {
@@ -111,12 +109,10 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
             }
             
             // 결과 캐싱
-            std::map<std::string, std::any> cache_entry;
-            cache_entry["gop_score"] = overall_score;
-            cache_entry["details"] = gop_result;
-            cache_entry["timestamp"] = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-            
-            cached_results[block_id] = cache_entry;
+            CachedEvaluation& cache_entry = cached_results[block_id];
+            cache_entry.gop_score = overall_score;
+            cache_entry.details = std::move(gop_result);
+            cache_entry.timestamp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
             
         } catch (const std::exception& e) {
             std::stringstream ss;
@@ -125,6 +121,14 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
         }
     }
     
+    if (skipped > 0) {
+        if (LogEnabled(LogLevel::DEBUG)) {
+            std::stringstream ss;
+            ss << "후보 " << candidates.size() << "개 중 " << skipped << "개는 키워드 검출 점수로 제외";
+            LOG_DEBUG("EvaluationController", ss.str());
+        }
+    }
+    
     // 최적 매치 블록을 찾았으면 해당 블록 평가 진행
     if (best_match_id >= 0 && best_match_score >= confidence_threshold) {
         // 평가 가능한 시점인지 확인
@@ -134,6 +138,9 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
                              current_time - last_eval_time.value()).count() / 1000.0 >= min_time_between_evals;
         
         if (can_evaluate) {
+            // 발화 속도/윈도우 크기 갱신 (기대 블록은 활성 블록)
+            progress_tracker->ObserveEvaluation(best_match_id, best_match_id == sentence_manager->active_block_id);
+            
             // 어떤 블록이든 매치된 블록 평가
             EvaluateBlock(best_match_id, cached_results[best_match_id]);
             last_eval_time = current_time;
@@ -182,13 +189,234 @@ std::map<std::string, std::any> EvaluationController::ProcessRecognitionResult(
                 progress_tracker->SetCurrentIndex(sentence_manager->active_block_id);
             }
         }
+    } else if (!candidates.empty()) {
+        // 확신할 수 있는 매치가 없으면 다음 청크는 더 넓은 윈도우로 찾는다
+        progress_tracker->ObserveMiss();
     }
     
     // 새 형식으로 결과 반환
+    SpillBlocks();
     return CreateResultFormat();
 }
 
-std::map<std::string, std::any> EvaluationController::CreateResultFormat() const {
+void EvaluationController::EnableIncrementalAlignment(const IncrementalAligner::Options& options) {
+    aligner = std::make_unique<IncrementalAligner>(recognition_engine, plan, options);
+    LOG_INFO("EvaluationController", "문장 전체 증분 정렬 모드");
+}
+
+EvaluationResult EvaluationController::ProcessIncremental(const Wav2VecCTCOnnxCore::EncoderOutput& output) {
+    // 새 청크의 프레임만 정렬에 이어 붙이고, frontier가 지나간 블록을 한 번씩 확정한다
+    try {
+        ApplyAlignedBlocks(aligner->Extend(output));
+    } catch (const std::exception& e) {
+        std::stringstream ss;
+        ss << "증분 정렬 중 오류: " << e.what();
+        LOG_ERROR("EvaluationController", ss.str());
+    }
+    
+    return CreateResultFormat();
+}
+
+bool EvaluationController::FinishAlignment() {
+    if (!aligner) {
+        return false;
+    }
+    
+    auto blocks = aligner->Finish();
+    ApplyAlignedBlocks(blocks);
+    return !blocks.empty();
+}
+
+void EvaluationController::ApplyAlignedBlocks(const std::vector<IncrementalAligner::BlockScore>& blocks) {
+    if (blocks.empty()) {
+        return;
+    }
+    
+    for (const auto& block_score : blocks) {
+        progress_tracker->ObserveEvaluation(block_score.block_id, true);
+        
+        CachedEvaluation& cache_entry = cached_results[block_score.block_id];
+        cache_entry.gop_score = block_score.result.overall;
+        cache_entry.coverage = block_score.coverage;
+        cache_entry.details = block_score.result;
+        cache_entry.timestamp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        
+        EvaluateBlock(block_score.block_id, cache_entry);
+    }
+    
+    // 활성 블록은 확정되지 않은 첫 블록 (모두 확정되면 마지막 블록에 머문다)
+    const int total_blocks = static_cast<int>(sentence_manager->blocks.size());
+    int next_block = aligner->NextBlock();
+    if (next_block < total_blocks) {
+        sentence_manager->SetActiveBlock(next_block);
+    }
+    progress_tracker->SetCurrentIndex(std::min(next_block, total_blocks - 1));
+    SpillBlocks();
+}
+
+void EvaluationController::EnableFrameStore(const FrameStore::Options& options) {
+    frame_store = options.max_bytes > 0 ? std::make_unique<FrameStore>(options) : nullptr;
+}
+
+std::optional<GopResult> EvaluationController::RescoreBlock(
+    int block_id,
+    double begin_seconds,
+    double end_seconds) const {
+    
+    if (!frame_store || block_id < 0 || block_id >= static_cast<int>(plan->blocks.size())) {
+        return std::nullopt;
+    }
+    
+    Wav2VecCTCOnnxCore::EncoderOutput output;
+    if (!frame_store->Read(begin_seconds, end_seconds, output)) {
+        std::stringstream ss;
+        ss << "재채점 구간 [" << begin_seconds << ", " << end_seconds << ")의 프레임이 보관되어 있지 않음";
+        LOG_DEBUG("EvaluationController", ss.str());
+        return std::nullopt;
+    }
+    
+    try {
+        return recognition_engine->ScoreBlock(output, plan->blocks[block_id]);
+    } catch (const std::exception& e) {
+        std::stringstream ss;
+        ss << "블록 " << block_id << " 재채점 중 오류: " << e.what();
+        LOG_ERROR("EvaluationController", ss.str());
+        return std::nullopt;
+    }
+}
+
+std::optional<FrameStore::Stats> EvaluationController::GetFrameStoreStats() const {
+    if (!frame_store) {
+        return std::nullopt;
+    }
+    return frame_store->GetStats();
+}
+
+int EvaluationController::MergeSegmentAlignment(
+    const Wav2VecCTCOnnxCore::EncoderOutput& output,
+    float segment_duration,
+    float remaining_duration) {
+    
+    const int total_blocks = static_cast<int>(sentence_manager->blocks.size());
+    const int frontier = segment_frontier;
+    const int remaining_blocks = total_blocks - frontier;
+    if (frame_store) {
+        // 장문의 시간축은 무음뿐인 세그먼트를 뺀 세그먼트들을 이어 붙인 것이다
+        frame_store->Append(output, segment_duration);
+    }
+    if (remaining_blocks <= 0 || output.hidden.rows() == 0) {
+        return 0;
+    }
+    
+    // 남은 발화 시간 대비 세그먼트 길이로 담긴 블록 수를 추정하고, 여유를 두어 후보 창을 잡는다
+    bool is_last = segment_duration >= remaining_duration - 1e-3f;
+    int expected_blocks = remaining_blocks;
+    int window = remaining_blocks;
+    if (!is_last && remaining_duration > 0.0f) {
+        expected_blocks = std::max(1, static_cast<int>(
+            std::lround(remaining_blocks * segment_duration / remaining_duration)));
+        window = std::min(remaining_blocks, 2 * expected_blocks + 3);
+    }
+    
+    std::vector<Wav2VecCTCOnnxCore::SegmentBlockScore> block_scores;
+    try {
+        block_scores = recognition_engine->AlignSegmentToBlocks(output, *plan, frontier, window, expected_blocks);
+    } catch (const std::exception& e) {
+        std::stringstream ss;
+        ss << "세그먼트 정렬 중 오류: " << e.what();
+        LOG_ERROR("EvaluationController", ss.str());
+        return 0;
+    }
+    
+    // 앞에서부터 절반 이상 정렬된 블록을 소비 (마지막 세그먼트는 남은 블록 전체)
+    int consumed = 0;
+    for (const auto& block_score : block_scores) {
+        if (block_score.coverage < 0.5f && !(is_last && block_score.coverage > 0.0f)) {
+            break;
+        }
+        
+        int block_id = frontier + consumed;
+        CachedEvaluation& cache_entry = cached_results[block_id];
+        cache_entry.gop_score = block_score.score;
+        cache_entry.coverage = block_score.coverage;
+        cache_entry.timestamp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        
+        EvaluateBlock(block_id, cache_entry);
+        consumed++;
+    }
+    
+    if (consumed > 0) {
+        segment_frontier = frontier + consumed;
+        // 마지막 블록까지 평가되었으면 활성 블록은 그대로 둔다 (EVALUATED 상태 유지)
+        if (segment_frontier < total_blocks) {
+            sentence_manager->SetActiveBlock(segment_frontier);
+        }
+        progress_tracker->SetCurrentIndex(std::min(segment_frontier, total_blocks - 1));
+        SpillBlocks();
+    }
+    
+    std::stringstream ss;
+    ss << "세그먼트 병합: frontier=" << frontier << ", 예상 " << expected_blocks
+       << " 블록, 후보 " << window << " 블록 → " << consumed << " 블록 소비";
+    LOG_INFO("EvaluationController", ss.str());
+    
+    return consumed;
+}
+
+void EvaluationController::EnableResidency(size_t resident_blocks, SpillSink sink) {
+    sentence_manager->SetResidency(resident_blocks);
+    spill_sink = std::move(sink);
+}
+
+void EvaluationController::SpillBlocks() {
+    for (const auto& block : sentence_manager->SpillFinalized()) {
+        cached_results.erase(block.block_id);
+        pending_evaluations.erase(block.block_id);
+        if (spill_sink) {
+            spill_sink(block);
+        }
+    }
+}
+
+EvaluationResult EvaluationController::CreateLongFormResult() const {
+    const auto& aggregates = sentence_manager->GetAggregates();
+    EvaluationResult result;
+    if (aggregates.completed == 0) {
+        return result;
+    }
+    
+    float avg_score_rounded = std::round(static_cast<float>(aggregates.score_sum / aggregates.completed) * 10) / 10;
+    result.overall = avg_score_rounded;
+    result.pronunciation = avg_score_rounded;
+    
+    // 평가된 블록은 상주 범위 안, 마지막으로 평가된 블록까지에만 있다
+    for (int i = sentence_manager->ResidentBegin(); i <= aggregates.last_evaluated; ++i) {
+        const auto& block = sentence_manager->blocks[i];
+        if (block && block->status == BlockStatus::EVALUATED && block->gop_score.has_value()) {
+            result.words.push_back({block->text, std::round(block->gop_score.value() * 10) / 10});
+        }
+    }
+    
+    if (aggregates.completed == sentence_manager->blocks.size()) {
+        result.eof = true;
+        result.final_score = avg_score_rounded;
+        
+        ResultDetails details;
+        details.total_blocks = sentence_manager->blocks.size();
+        details.completion_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        details.score_breakdown.min_score = std::round(aggregates.min_score * 10) / 10;
+        details.score_breakdown.max_score = std::round(aggregates.max_score * 10) / 10;
+        result.details = details;
+    }
+    
+    return result;
+}
+
+EvaluationResult EvaluationController::CreateResultFormat() const {
+    if (sentence_manager->GetResidency() > 0) {
+        return CreateLongFormResult();
+    }
+    
     // 평가된 블록 수집
     std::vector<std::shared_ptr<SentenceBlock>> evaluated_blocks;
     for (const auto& block : sentence_manager->blocks) {
@@ -198,19 +426,9 @@ std::map<std::string, std::any> EvaluationController::CreateResultFormat() const
     }
     
     // 평가된 블록이 없으면 빈 결과 반환
+    EvaluationResult result;
     if (evaluated_blocks.empty()) {
-        std::map<std::string, std::any> empty_result;
-        
-        std::map<std::string, std::any> inner_result;
-        inner_result["overall"] = 0.0f;
-        inner_result["pronunciation"] = 0.0f;
-        inner_result["resource_version"] = std::string("1.0.0");
-        inner_result["words"] = std::vector<std::map<std::string, std::any>>();
-        inner_result["eof"] = false;
-        
-        empty_result["result"] = inner_result;
-        
-        return empty_result;
+        return result;
     }
     
     // 평균 점수 계산
@@ -226,74 +444,45 @@ std::map<std::string, std::any> EvaluationController::CreateResultFormat() const
     float avg_score_rounded = std::round(avg_score * 10) / 10;
     
     // 단어별 점수 구성
-    std::vector<std::map<std::string, std::any>> words;
+    result.words.reserve(evaluated_blocks.size());
     for (const auto& block : evaluated_blocks) {
         if (block->gop_score.has_value()) {
-            std::map<std::string, std::any> word_map;
-            word_map["word"] = block->text;
-            
-            std::map<std::string, std::any> scores_map;
-            scores_map["pronunciation"] = std::round(block->gop_score.value() * 10) / 10;
-            word_map["scores"] = scores_map;
-            
-            words.push_back(word_map);
+            result.words.push_back({block->text, std::round(block->gop_score.value() * 10) / 10});
         }
     }
     
-    // 모든 블록이 평가 완료되었는지 확인
-    bool all_blocks_evaluated = evaluated_blocks.size() == sentence_manager->blocks.size();
-    
-    // 기본 결과 구조
-    std::map<std::string, std::any> result;
-    std::map<std::string, std::any> inner_result;
-    
-    inner_result["overall"] = avg_score_rounded;
-    inner_result["pronunciation"] = avg_score_rounded;
-    inner_result["resource_version"] = std::string("1.0.0");
-    inner_result["words"] = words;
-    inner_result["eof"] = false;
+    result.overall = avg_score_rounded;
+    result.pronunciation = avg_score_rounded;
     
     // 모든 블록이 평가 완료된 경우 추가 정보 포함
-    if (all_blocks_evaluated) {
-        inner_result["eof"] = true;
-        inner_result["final_score"] = avg_score_rounded;
+    if (evaluated_blocks.size() == sentence_manager->blocks.size()) {
+        result.eof = true;
+        result.final_score = avg_score_rounded;
         
         // 강화된 결과 데이터 추가
-        std::map<std::string, std::any> details;
-        details["total_blocks"] = sentence_manager->blocks.size();
-        details["completion_time"] = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-        
-        std::map<std::string, std::any> score_breakdown;
+        ResultDetails details;
+        details.total_blocks = sentence_manager->blocks.size();
+        details.completion_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
         
-        // 최소 점수 계산
+        // 최소/최대 점수 계산
         float min_score = std::numeric_limits<float>::max();
-        for (const auto& block : evaluated_blocks) {
-            if (block->gop_score.has_value() && block->gop_score.value() < min_score) {
-                min_score = block->gop_score.value();
-            }
-        }
-        
-        // 최대 점수 계산
         float max_score = -std::numeric_limits<float>::max();
         for (const auto& block : evaluated_blocks) {
-            if (block->gop_score.has_value() && block->gop_score.value() > max_score) {
-                max_score = block->gop_score.value();
+            if (block->gop_score.has_value()) {
+                min_score = std::min(min_score, block->gop_score.value());
+                max_score = std::max(max_score, block->gop_score.value());
             }
         }
         
-        score_breakdown["min_score"] = std::round(min_score * 10) / 10;
-        score_breakdown["max_score"] = std::round(max_score * 10) / 10;
-        
-        details["score_breakdown"] = score_breakdown;
-        inner_result["details"] = details;
+        details.score_breakdown.min_score = std::round(min_score * 10) / 10;
+        details.score_breakdown.max_score = std::round(max_score * 10) / 10;
+        result.details = details;
     }
     
-    result["result"] = inner_result;
-    
     return result;
 }
 
-void EvaluationController::EvaluateBlock(int block_id, const std::map<std::string, std::any>& evaluation_data) {
+void EvaluationController::EvaluateBlock(int block_id, const CachedEvaluation& evaluation) {
     auto block = sentence_manager->GetBlock(block_id);
     if (!block) {
         return;
@@ -305,8 +494,7 @@ void EvaluationController::EvaluateBlock(int block_id, const std::map<std::strin
     }
     
     // GOP 점수 설정
-    float gop_score = std::any_cast<float>(evaluation_data.at("gop_score"));
-    sentence_manager->SetBlockScore(block_id, gop_score);
+    sentence_manager->SetBlockScore(block_id, evaluation.gop_score);
     
     // 상태를 EVALUATED로 업데이트
     sentence_manager->UpdateBlockStatus(block_id, BlockStatus::EVALUATED);
@@ -316,61 +504,59 @@ void EvaluationController::EvaluateBlock(int block_id, const std::map<std::strin
     LOG_INFO("EvaluationController", ss.str());
 }
 
-std::map<std::string, std::any> EvaluationController::GetEvaluationSummary() const {
-    // 평가된 블록 수집
-    std::vector<std::shared_ptr<SentenceBlock>> evaluated_blocks;
+EvaluationSummary EvaluationController::GetEvaluationSummary() const {
+    EvaluationSummary summary;
+    summary.total = sentence_manager->blocks.size();
+    
+    if (sentence_manager->GetResidency() > 0) {
+        // 장문 모드: 누적 집계와 상주 블록만
+        const auto& aggregates = sentence_manager->GetAggregates();
+        summary.completed = aggregates.completed;
+        if (summary.completed > 0) {
+            summary.overall_score = std::round(static_cast<float>(aggregates.score_sum / summary.completed) * 10) / 10;
+            summary.blocks = sentence_manager->GetBlockResults(sentence_manager->ResidentBegin(),
+                                                               sentence_manager->ResidentEnd());
+        }
+        return summary;
+    }
+    
+    // 평가된 블록 점수 합산
+    float total_score = 0.0f;
     for (const auto& block : sentence_manager->blocks) {
         if (block->status == BlockStatus::EVALUATED) {
-            evaluated_blocks.push_back(block);
+            summary.completed++;
+            if (block->gop_score.has_value()) {
+                total_score += block->gop_score.value();
+            }
         }
     }
     
     // 평가된 블록이 없으면 빈 요약 반환
-    if (evaluated_blocks.empty()) {
-        std::map<std::string, std::any> empty_summary;
-        empty_summary["overall_score"] = 0.0f;
-        
-        std::map<std::string, std::any> progress;
-        progress["completed"] = 0;
-        progress["total"] = sentence_manager->blocks.size();
-        empty_summary["progress"] = progress;
-        
-        empty_summary["blocks"] = std::vector<std::map<std::string, std::any>>();
-        
-        return empty_summary;
-    }
-    
-    // 평균 점수 계산
-    float avg_score = 0.0f;
-    for (const auto& block : evaluated_blocks) {
-        if (block->gop_score.has_value()) {
-            avg_score += block->gop_score.value();
-        }
+    if (summary.completed == 0) {
+        return summary;
     }
-    avg_score /= evaluated_blocks.size();
     
-    // 결과 구성
-    std::map<std::string, std::any> summary;
-    summary["overall_score"] = std::round(avg_score * 10) / 10;
-    
-    std::map<std::string, std::any> progress;
-    progress["completed"] = evaluated_blocks.size();
-    progress["total"] = sentence_manager->blocks.size();
-    summary["progress"] = progress;
-    
-    std::vector<std::map<std::string, std::any>> blocks_status;
-    for (const auto& block : sentence_manager->blocks) {
-        blocks_status.push_back(block->ToDict());
-    }
-    summary["blocks"] = blocks_status;
+    summary.overall_score = std::round(total_score / summary.completed * 10) / 10;
+    summary.blocks = sentence_manager->GetAllBlockResults();
     
     return summary;
 }
 
+EvaluationResult EvaluationController::GetResult() const {
+    return CreateResultFormat();
+}
+
 void EvaluationController::Reset() {
     last_eval_time = std::nullopt;
+    segment_frontier = 0;
     pending_evaluations.clear();
     cached_results.clear();
+    if (aligner) {
+        aligner->Reset();
+    }
+    if (frame_store) {
+        frame_store->Clear();
+    }
     
     LOG_INFO("EvaluationController", "평가 상태 초기화");
 }
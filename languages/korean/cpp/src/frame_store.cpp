@@ -0,0 +1,189 @@
+// src/cpp/src/frame_store.cpp
+#include "realtime_engine_ko/frame_store.h"
+#include "realtime_engine_ko/common.h"
+#include <sstream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+// -log p를 [0, kMaxNegLogProb] 구간에서 255 단계로 양자화
+constexpr float kMaxNegLogProb = 16.0f;
+constexpr float kQuantScale = 255.0f / kMaxNegLogProb;
+
+const std::array<float, 256>& DequantTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values{};
+        for (int q = 0; q < 255; ++q) {
+            values[q] = std::exp(-static_cast<float>(q) / kQuantScale);
+        }
+        values[255] = 0.0f;  // 범위 밖(아주 작은 확률)은 0으로 복원
+        return values;
+    }();
+    return table;
+}
+
+} // namespace
+
+FrameStore::FrameStore() : FrameStore(Options()) {
+}
+
+FrameStore::FrameStore(const Options& options) : options(options) {
+}
+
+uint8_t FrameStore::Quantize(float prob) {
+    if (!(prob > 0.0f)) {
+        return 255;
+    }
+    float q = std::round(-std::log(prob) * kQuantScale);
+    return static_cast<uint8_t>(std::clamp(q, 0.0f, 255.0f));
+}
+
+void FrameStore::Append(const Wav2VecCTCOnnxCore::EncoderOutput& output, double audio_seconds) {
+    const int frames = static_cast<int>(output.probs.rows());
+    const int vocab = static_cast<int>(output.probs.cols());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const double start_time = end_time;
+    end_time += audio_seconds;
+    if (options.max_bytes == 0) {
+        evicted_until = end_time;
+        return;
+    }
+    if (frames == 0 || audio_seconds <= 0.0) {
+        return;
+    }
+
+    // 양자화는 잠금 안에서 하지만 청크당 프레임 × 어휘 한 번뿐이다
+    Chunk chunk;
+    chunk.start_time = start_time;
+    chunk.duration = audio_seconds;
+    chunk.frames = frames;
+    chunk.vocab = vocab;
+    chunk.log_probs.resize(static_cast<size_t>(frames) * vocab);
+    for (int t = 0; t < frames; ++t) {
+        uint8_t* row = chunk.log_probs.data() + static_cast<size_t>(t) * vocab;
+        for (int v = 0; v < vocab; ++v) {
+            row[v] = Quantize(output.probs(t, v));
+        }
+    }
+    if (options.store_hidden) {
+        chunk.hidden = output.hidden;
+    }
+    chunk.bytes = sizeof(Chunk) + chunk.log_probs.size() +
+                  static_cast<size_t>(chunk.hidden.size()) * sizeof(float);
+
+    total_bytes += chunk.bytes;
+    total_frames += frames;
+    chunks.push_back(std::move(chunk));
+
+    // 상한을 넘으면 오래된 청크부터 버린다 (방금 넣은 청크 하나는 남긴다)
+    while (total_bytes > options.max_bytes && chunks.size() > 1) {
+        const Chunk& oldest = chunks.front();
+        total_bytes -= oldest.bytes;
+        total_frames -= oldest.frames;
+        evicted_frames += oldest.frames;
+        evicted_until = oldest.start_time + oldest.duration;
+        chunks.pop_front();
+    }
+}
+
+void FrameStore::SkipTo(double seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (seconds <= end_time) {
+        return;
+    }
+    end_time = seconds;
+    if (options.max_bytes == 0) {
+        evicted_until = end_time;
+    }
+}
+
+bool FrameStore::Read(
+    double begin_seconds,
+    double end_seconds,
+    Wav2VecCTCOnnxCore::EncoderOutput& output) const {
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (end_seconds <= begin_seconds || begin_seconds < evicted_until) {
+        return false;
+    }
+
+    // 청크 안의 프레임은 청크 길이에 고르게 퍼져 있다고 본다 (프레임 k의 중심 = 시작 + (k + 0.5) × 길이/프레임 수)
+    struct Span {
+        const Chunk* chunk;
+        int first;
+        int last;  // exclusive
+    };
+    std::vector<Span> spans;
+    int total = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.start_time + chunk.duration <= begin_seconds || chunk.start_time >= end_seconds) {
+            continue;
+        }
+        const double frame_duration = chunk.duration / chunk.frames;
+        int first = static_cast<int>(std::ceil((begin_seconds - chunk.start_time) / frame_duration - 0.5));
+        int last = static_cast<int>(std::ceil((end_seconds - chunk.start_time) / frame_duration - 0.5));
+        first = std::clamp(first, 0, chunk.frames);
+        last = std::clamp(last, first, chunk.frames);
+        if (last > first) {
+            spans.push_back({&chunk, first, last});
+            total += last - first;
+        }
+    }
+    if (total == 0) {
+        return false;
+    }
+
+    // 어휘/히든 차원은 세션 동안 같다. 히든이 하나라도 없으면 히든 없이 복원한다
+    const int vocab = spans.front().chunk->vocab;
+    bool with_hidden = true;
+    for (const auto& span : spans) {
+        with_hidden = with_hidden && span.chunk->hidden.rows() == span.chunk->frames;
+    }
+    const Eigen::Index hidden_dim = with_hidden ? spans.front().chunk->hidden.cols() : 0;
+
+    const auto& table = DequantTable();
+    output.probs.resize(total, vocab);
+    output.hidden.resize(with_hidden ? total : 0, hidden_dim);
+    int row = 0;
+    for (const auto& span : spans) {
+        for (int t = span.first; t < span.last; ++t, ++row) {
+            const uint8_t* q = span.chunk->log_probs.data() + static_cast<size_t>(t) * vocab;
+            for (int v = 0; v < vocab; ++v) {
+                output.probs(row, v) = table[q[v]];
+            }
+            if (with_hidden) {
+                output.hidden.row(row) = span.chunk->hidden.row(t);
+            }
+        }
+    }
+    return true;
+}
+
+FrameStore::Stats FrameStore::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.chunks = chunks.size();
+    stats.frames = total_frames;
+    stats.bytes = total_bytes;
+    stats.evicted_frames = evicted_frames;
+    stats.begin_time = chunks.empty() ? end_time : chunks.front().start_time;
+    stats.end_time = end_time;
+    return stats;
+}
+
+void FrameStore::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks.clear();
+    total_bytes = 0;
+    total_frames = 0;
+    evicted_frames = 0;
+    evicted_until = 0.0;
+    end_time = 0.0;
+}
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,410 @@
+// src/cpp/src/incremental_aligner.cpp
+#include "realtime_engine_ko/incremental_aligner.h"
+#include "realtime_engine_ko/common.h"
+#include "realtime_engine_ko/stage_metrics.h"
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// dtw_align_cost의 AsymmetricP1 단계 패턴 + 같은 열에 머무는 hold (base offset만, 가중치는 AppendFrame에 풀어 씀)
+constexpr int kPatternDi[4] = {-1, -1, -2, -1};
+constexpr int kPatternDj[4] = {-2, -1, -1, 0};
+constexpr int kHoldPattern = 3;
+
+} // namespace
+
+IncrementalAligner::IncrementalAligner(
+    std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+    std::shared_ptr<const SentencePlan> plan)
+    : IncrementalAligner(std::move(recognition_engine), std::move(plan), Options()) {
+}
+
+IncrementalAligner::IncrementalAligner(
+    std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+    std::shared_ptr<const SentencePlan> plan,
+    const Options& options)
+    : recognition_engine(std::move(recognition_engine)),
+      plan(std::move(plan)),
+      options(options) {
+
+    this->options.frames_per_token = std::max(1, this->options.frames_per_token);
+    this->options.trim_margin_frames = std::max(0, this->options.trim_margin_frames);
+    this->options.band_tokens = std::max(1, this->options.band_tokens);
+    num_tokens = static_cast<int>(this->plan->sentence_tokens.ids.size());
+    num_columns = num_tokens * this->options.frames_per_token;
+    separator_id = this->recognition_engine->SeparatorId();
+    Reset();
+}
+
+double IncrementalAligner::CostRow::At(int column) const {
+    int index = column - first_column;
+    return index >= 0 && index < static_cast<int>(cost.size()) ? cost[index] : kInf;
+}
+
+void IncrementalAligner::Reset() {
+    // 행 0: D[0][0] = 0, 나머지는 도달 불가. 행 -1은 전부 도달 불가
+    cost_prev.first_column = 0;
+    cost_prev.cost.assign(1, 0.0);
+    cost_prev2.first_column = 0;
+    cost_prev2.cost.clear();
+    cost_current.cost.clear();
+    distance_prev.clear();
+    distance_prev_first_token = 0;
+    best_column = 0;
+    dir_rows.clear();
+    trimmed_frames = 0;
+    num_frames = 0;
+
+    first_column = 1;
+    next_block = 0;
+    frontier_token = -1;
+}
+
+double IncrementalAligner::LocalCost(const DistanceRow& distances, int column) const {
+    int index = (column - 1) / options.frames_per_token - distances.first_token;
+    if (column < 1 || index < 0 || index >= distances.num_tokens) {
+        return kInf;
+    }
+    return static_cast<double>(distances.data[index]);
+}
+
+void IncrementalAligner::AppendFrame(const DistanceRow& current, const DistanceRow& previous, double pause_cost) {
+    const int fpt = options.frames_per_token;
+    const int band = options.band_tokens * fpt;
+    const int i = static_cast<int>(num_frames) + 1;  // 1부터 시작하는 행 번호
+
+    // 계산할 열: 확정되지 않은 블록 안에서 직전 최선 열 ± band, 거리를 구한 토큰 범위 안.
+    // 직전 행에서 도달한 마지막 열보다 두 열 넘게 앞설 수는 없다. 첫 블록을 확정하기 전에는 열 0(앞쪽 무음)도 계산한다
+    const int column_floor = next_block == 0 ? 0 : first_column;
+    const int lo = std::max(column_floor, best_column - band);
+    const int hi = std::min({num_columns, best_column + band, cost_prev.LastColumn() + 2,
+                             (current.first_token + current.num_tokens) * fpt});
+
+    DirRow row;
+    row.first_column = lo;
+    cost_current.first_column = lo;
+    cost_current.cost.assign(static_cast<size_t>(std::max(0, hi - lo + 1)), kInf);
+    if (hi >= lo) {
+        row.dir.assign(hi - lo + 1, -1);
+    }
+
+    double row_best = kInf;
+    int row_best_column = -1;
+    for (int j = lo; j <= hi; ++j) {
+        double here = LocalCost(current, j);
+        double best = kInf;
+        int best_p = -1;
+
+        // 패턴 0: (i-1, j-2) -> (i, j-1) -> (i, j), 가중치 0.5씩
+        if (j >= 2) {
+            double c = cost_prev.At(j - 2);
+            c += 0.5 * LocalCost(current, j - 1);
+            c += 0.5 * here;
+            if (c < best) {
+                best = c;
+                best_p = 0;
+            }
+        }
+
+        // 패턴 1: (i-1, j-1) -> (i, j)
+        {
+            double c = cost_prev.At(j - 1) + here;
+            if (c < best) {
+                best = c;
+                best_p = 1;
+            }
+        }
+
+        // 패턴 2: (i-2, j-1) -> (i-1, j) -> (i, j)
+        if (i >= 2) {
+            double c = cost_prev2.At(j - 1) + LocalCost(previous, j) + here;
+            if (c < best) {
+                best = c;
+                best_p = 2;
+            }
+        }
+
+        // hold: (i-1, j) -> (i, j), 로컬 비용은 토큰과 blank 중 가까운 쪽 (열 0은 blank만).
+        // 가중치 1이라 모든 경로의 가중치 합은 여전히 행 수와 같다
+        {
+            double c = cost_prev.At(j) + std::min(here, pause_cost);
+            if (c < best) {
+                best = c;
+                best_p = kHoldPattern;
+            }
+        }
+
+        cost_current.cost[j - lo] = best;
+        row.dir[j - lo] = static_cast<int8_t>(best_p);
+        if (best < row_best) {
+            row_best = best;
+            row_best_column = j;
+        }
+    }
+
+    if (row_best_column < 0 && best_column >= 1 && std::isfinite(cost_prev.At(best_column))) {
+        // band 안에 도달 가능한 칸이 없으면 직전 최선 열에 머문다 (경로가 끊겨 이후 채점이 멈추지 않도록)
+        double here = LocalCost(current, best_column);
+        row.first_column = best_column;
+        row.dir.assign(1, static_cast<int8_t>(kHoldPattern));
+        cost_current.first_column = best_column;
+        cost_current.cost.assign(1, cost_prev.At(best_column) + (std::isfinite(here) ? here : 0.0));
+        row_best_column = best_column;
+        LOG_WARNING("IncrementalAligner", "band 안에 도달 가능한 열이 없어 열 " + std::to_string(best_column) +
+                    "에 머묾 (프레임 " + std::to_string(i) + ")");
+    }
+
+    // 버퍼 순환: prev2 <- prev <- current
+    std::swap(cost_prev2, cost_prev);
+    std::swap(cost_prev, cost_current);
+    if (row_best_column >= 0) {
+        best_column = row_best_column;
+    }
+
+    dir_rows.push_back(std::move(row));
+    num_frames++;
+}
+
+int IncrementalAligner::BestEndColumn() const {
+    // open-end: 마지막 행에서 누적 비용이 최소인 열 (모든 단계의 가중치 합이 행 수라 열 간 비교 가능).
+    // 열 0(앞쪽 무음)이 최선이면 -1
+    if (num_frames == 0 || best_column < first_column || !std::isfinite(cost_prev.At(best_column))) {
+        return -1;
+    }
+    return best_column;
+}
+
+void IncrementalAligner::Backtrack(
+    int end_column,
+    int first_token,
+    std::vector<int>& token_frames,
+    std::vector<int>& token_first_frame,
+    std::vector<float>& raw_scores,
+    float eps) const {
+
+    const int fpt = options.frames_per_token;
+    std::vector<float> sum_log_p(num_tokens, 0.0f);
+    token_frames.assign(num_tokens, 0);
+    token_first_frame.assign(num_tokens, -1);
+
+    int i = static_cast<int>(num_frames);
+    int j = end_column;
+    while (i > static_cast<int>(trimmed_frames) && j > 0) {
+        int token = (j - 1) / fpt;
+        if (token < first_token) {
+            break;
+        }
+
+        const DirRow& row = dir_rows[i - 1 - trimmed_frames];
+        int index = j - row.first_column;
+        if (index < 0 || index >= static_cast<int>(row.dir.size())) {
+            break;  // 이 행에서 계산하지 않은 열
+        }
+
+        // hold로 머문 프레임(템플릿보다 길게 끈 발음, 쉼)은 점수에 넣지 않는다.
+        // 열에는 항상 hold가 아닌 단계로 들어오므로 경로가 지난 토큰은 한 프레임 이상 세어진다
+        int p = row.dir[index];
+        token_first_frame[token] = i - 1;
+        if (p != kHoldPattern) {
+            token_frames[token]++;
+            sum_log_p[token] += std::log(row.probs[token - row.first_token] + eps);
+        }
+
+        if (p < 0) {
+            break;  // 도달 불가능한 셀
+        }
+        i += kPatternDi[p];
+        j += kPatternDj[p];
+    }
+
+    // 토큰별 평균 로그 확률 (정렬된 프레임이 없으면 -inf, ScoreTokenFrames와 같은 규칙)
+    raw_scores.assign(num_tokens, -std::numeric_limits<float>::infinity());
+    for (int k = first_token; k < num_tokens; ++k) {
+        if (token_frames[k] > 0) {
+            raw_scores[k] = sum_log_p[k] / token_frames[k];
+        }
+    }
+}
+
+std::vector<IncrementalAligner::BlockScore> IncrementalAligner::FinalizeBlocks(
+    int last_block,
+    int end_column,
+    bool at_end,
+    float eps) {
+
+    const auto& spans = plan->block_token_spans;
+    const int num_blocks = static_cast<int>(spans.size());
+    const int first_block = next_block;
+
+    // 정규화 컨텍스트(앞 블록들)까지만 역추적한다
+    int context_block = std::max(0, first_block - SentencePlan::kContextBlocks);
+    std::vector<int> token_frames;
+    std::vector<int> token_first_frame;
+    std::vector<float> raw_scores;
+    {
+        ScopedStageTimer timer(Stage::ALIGN);
+        Backtrack(end_column, static_cast<int>(spans[context_block].first), token_frames, token_first_frame,
+                  raw_scores, eps);
+    }
+
+    std::vector<BlockScore> finalized;
+    for (int b = first_block; b <= last_block; ++b) {
+        const auto [begin, end] = spans[b];
+
+        int aligned = 0;
+        for (size_t k = begin; k < end; ++k) {
+            aligned += token_frames[k] > 0 ? 1 : 0;
+        }
+        if (at_end && aligned == 0) {
+            continue;
+        }
+
+        // ScoreBlock처럼 앞뒤 kContextBlocks 블록 범위로 정규화 (뒤쪽은 지금까지 정렬된 토큰까지)
+        size_t norm_begin = spans[std::max(0, b - SentencePlan::kContextBlocks)].first;
+        size_t norm_end = spans[std::min(num_blocks - 1, b + SentencePlan::kContextBlocks)].second;
+        norm_end = std::max(end, std::min(norm_end, static_cast<size_t>(frontier_token + 1)));
+
+        BlockScore score;
+        score.block_id = b;
+        score.coverage = end > begin ? static_cast<float>(aligned) / (end - begin) : 0.0f;
+        score.result = recognition_engine->ScoreAlignedTokens(
+            plan->sentence_tokens, raw_scores, norm_begin, norm_end, begin, end, eps);
+        finalized.push_back(std::move(score));
+    }
+
+    // 이후 행은 확정되지 않은 첫 블록의 시작 열부터만 계산한다
+    next_block = last_block + 1;
+    if (next_block < num_blocks) {
+        first_column = static_cast<int>(spans[next_block].first) * options.frames_per_token + 1;
+
+        // 다음 확정의 컨텍스트 블록이 정렬된 첫 프레임 앞쪽(여유분 제외)은 다시 역추적할 일이 없다
+        int next_context_token = static_cast<int>(spans[std::max(0, next_block - SentencePlan::kContextBlocks)].first);
+        for (int k = next_context_token; k < num_tokens; ++k) {
+            if (token_first_frame[k] >= 0) {
+                int trim_to = token_first_frame[k] - options.trim_margin_frames;
+                if (trim_to > 0) {
+                    TrimRowsBefore(static_cast<size_t>(trim_to));
+                }
+                break;
+            }
+        }
+    }
+
+    if (LogEnabled(LogLevel::DEBUG)) {
+        std::stringstream ss;
+        ss << "증분 정렬: 블록 " << first_block << "~" << last_block << " 확정 (프레임 " << num_frames
+           << ", 보관 " << dir_rows.size() << ", frontier 토큰 " << frontier_token << "/" << num_tokens << ")";
+        LOG_DEBUG("IncrementalAligner", ss.str());
+    }
+
+    return finalized;
+}
+
+void IncrementalAligner::TrimRowsBefore(size_t frame) {
+    while (trimmed_frames < frame && !dir_rows.empty()) {
+        dir_rows.pop_front();
+        trimmed_frames++;
+    }
+}
+
+std::vector<IncrementalAligner::BlockScore> IncrementalAligner::Extend(
+    const Wav2VecCTCOnnxCore::EncoderOutput& output,
+    float eps) {
+
+    const int num_blocks = static_cast<int>(plan->block_token_spans.size());
+    if (num_tokens == 0 || next_block >= num_blocks || output.hidden.rows() == 0) {
+        return {};
+    }
+
+    int end_column = -1;
+    {
+        ScopedStageTimer timer(Stage::ALIGN);
+
+        // 이 청크에서 닿을 수 있는 열(직전 최선 열 ± band, 프레임마다 최대 두 열 전진)의 토큰과
+        // 패턴 0이 참조하는 바로 앞 토큰에 대해서만 새 프레임의 거리를 계산한다
+        const int fpt = options.frames_per_token;
+        const int band = options.band_tokens * fpt;
+        const Eigen::Index frames = output.hidden.rows();
+        const int lo_column = std::max(first_column, best_column - band);
+        const int hi_column = std::min(num_columns, best_column + band + 2 * static_cast<int>(frames));
+        const int distance_first_token = std::max(0, (lo_column - 1) / fpt - 1);
+        const int distance_count = std::max(0, (hi_column - 1) / fpt) - distance_first_token + 1;
+
+        const int* ids = plan->sentence_tokens.ids.data();
+        Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> distances =
+            recognition_engine->TokenDistances(output.hidden, ids + distance_first_token, distance_count);
+        Wav2VecCTCOnnxCore::MatrixXf pause_distances = recognition_engine->TokenDistances(output.hidden, &separator_id, 1);
+
+        DistanceRow previous{distance_prev.data(), distance_prev_first_token, static_cast<int>(distance_prev.size())};
+        for (Eigen::Index t = 0; t < frames; ++t) {
+            DistanceRow current{distances.row(t).data(), distance_first_token, distance_count};
+            AppendFrame(current, previous, pause_distances(t, 0));
+            previous = current;
+
+            // 역추적은 이 행에서 계산한 열만 지나므로 그 열들의 토큰 확률만 보관한다
+            DirRow& row = dir_rows.back();
+            if (!row.dir.empty()) {
+                row.first_token = (row.first_column - 1) / fpt;
+                int last_token = (row.first_column + static_cast<int>(row.dir.size()) - 2) / fpt;
+                row.probs.resize(last_token - row.first_token + 1);
+                for (int k = row.first_token; k <= last_token; ++k) {
+                    row.probs[k - row.first_token] = output.probs(t, ids[k]);
+                }
+            }
+        }
+        distance_prev.assign(previous.data, previous.data + previous.num_tokens);
+        distance_prev_first_token = previous.first_token;
+
+        end_column = BestEndColumn();
+    }
+    if (end_column < 0) {
+        if (best_column > 0) {
+            LOG_WARNING("IncrementalAligner", "정렬 경로 없음 (프레임 " + std::to_string(num_frames) + "), 확정 보류");
+        }
+        return {};  // best_column 0: 아직 첫 토큰 앞의 무음
+    }
+    frontier_token = (end_column - 1) / options.frames_per_token;
+
+    // frontier가 블록 마지막 토큰을 margin 이상 지난 블록까지 확정 (마지막 블록은 Finish에서)
+    const auto& spans = plan->block_token_spans;
+    int last_block = next_block - 1;
+    while (last_block + 1 < num_blocks - 1 &&
+           frontier_token >= static_cast<int>(spans[last_block + 1].second) - 1 + options.finalize_margin_tokens) {
+        last_block++;
+    }
+
+    if (last_block < next_block) {
+        return {};
+    }
+    return FinalizeBlocks(last_block, end_column, false, eps);
+}
+
+std::vector<IncrementalAligner::BlockScore> IncrementalAligner::Finish(float eps) {
+    const int num_blocks = static_cast<int>(plan->block_token_spans.size());
+    if (num_frames == 0 || next_block >= num_blocks) {
+        return {};
+    }
+
+    int end_column = BestEndColumn();
+    if (end_column < 0 && best_column == 0) {
+        return {};  // 무음만 들어왔다
+    }
+    if (end_column < 0) {
+        // 조용히 빠뜨리지 않고 남은 블록을 정렬된 프레임 없이(coverage 0) 확정한다
+        LOG_WARNING("IncrementalAligner", "정렬 경로 없음: 남은 블록 " + std::to_string(num_blocks - next_block) +
+                    "개를 정렬 없이 확정");
+        return FinalizeBlocks(num_blocks - 1, 0, false, eps);
+    }
+    frontier_token = (end_column - 1) / options.frames_per_token;
+
+    return FinalizeBlocks(num_blocks - 1, end_column, true, eps);
+}
+
+} // namespace realtime_engine_ko
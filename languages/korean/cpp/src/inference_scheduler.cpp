@@ -0,0 +1,256 @@
+// src/cpp/src/inference_scheduler.cpp
+#include "realtime_engine_ko/inference_scheduler.h"
+#include <algorithm>
+#include <any>
+#include <sstream>
+
+namespace realtime_engine_ko {
+
+InferenceScheduler::InferenceScheduler() : InferenceScheduler(Options()) {
+}
+
+InferenceScheduler::InferenceScheduler(const Options& options)
+    : options(options), next_session_id(1), stopping(false) {
+    size_t num_threads = options.num_threads;
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(&InferenceScheduler::WorkerLoop, this);
+    }
+    LOG_INFO("InferenceScheduler", "InferenceScheduler 초기화: " + std::to_string(num_threads) + " 스레드");
+}
+
+InferenceScheduler::~InferenceScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    idle_cv.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+InferenceScheduler::SessionId InferenceScheduler::RegisterSession(float latency_slo, ChunkHandler handler) {
+    auto session = std::make_shared<Session>();
+    session->latency_slo = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(std::max(0.0f, latency_slo)));
+    session->handler = std::move(handler);
+    session->recent.reserve(kRecentSamples);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    SessionId id = next_session_id++;
+    sessions.emplace(id, std::move(session));
+    return id;
+}
+
+void InferenceScheduler::UnregisterSession(SessionId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return;
+    }
+
+    // 작업자가 아직 참조할 수 있으므로 shared_ptr을 잡아 두고 실행 종료를 기다린다
+    auto session = it->second;
+    sessions.erase(it);
+    session->removed = true;
+    session->pending.clear();
+    idle_cv.wait(lock, [&session]() { return !session->running; });
+}
+
+void InferenceScheduler::Submit(SessionId id, const AudioTensor& chunk, const MetadataMap& metadata,
+                                Clock::time_point arrival) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(id);
+        if (it == sessions.end() || stopping) {
+            return;
+        }
+
+        Session& session = *it->second;
+        session.pending.push_back(Job{chunk, metadata, arrival, arrival + session.latency_slo});
+        session.stats.submitted++;
+        MakeReady(id, session);
+    }
+    work_cv.notify_one();
+}
+
+void InferenceScheduler::Drain(SessionId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return;
+    }
+
+    auto session = it->second;
+    idle_cv.wait(lock, [this, &session]() {
+        return stopping || session->removed || (session->pending.empty() && !session->running);
+    });
+}
+
+void InferenceScheduler::Cancel(SessionId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return;
+    }
+
+    // ready 힙의 항목은 작업자가 꺼낼 때 빈 큐로 확인하고 건너뛴다
+    auto session = it->second;
+    session->pending.clear();
+    idle_cv.wait(lock, [&session]() { return !session->running; });
+}
+
+bool InferenceScheduler::WaitForBacklog(SessionId id, size_t max_pending, Clock::duration timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return true;
+    }
+
+    // 작업 완료/버림마다 idle_cv가 울린다
+    auto session = it->second;
+    return idle_cv.wait_for(lock, timeout, [this, &session, max_pending]() {
+        return stopping || session->removed || session->pending.size() <= max_pending;
+    });
+}
+
+InferenceScheduler::SessionStats InferenceScheduler::GetSessionStats(SessionId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return SessionStats();
+    }
+
+    const Session& session = *it->second;
+    SessionStats stats = session.stats;
+    if (stats.completed > 0) {
+        stats.mean_time_to_score = session.total_time_to_score / static_cast<double>(stats.completed);
+    }
+    if (!session.recent.empty()) {
+        std::vector<double> sorted = session.recent;
+        size_t index = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        stats.p99_time_to_score = sorted[index];
+    }
+    return stats;
+}
+
+void InferenceScheduler::MakeReady(SessionId id, Session& session) {
+    // 세션당 힙 항목은 최대 하나 (실행 중이면 끝난 뒤 다음 청크를 올린다)
+    if (session.running || session.queued || session.pending.empty()) {
+        return;
+    }
+    ready.push(ReadyEntry{session.pending.front().deadline, id});
+    session.queued = true;
+}
+
+void InferenceScheduler::Coalesce(Session& session, Job& job) {
+    // 이미 늦은 청크는 뒤에 쌓인 청크를 이어 붙여 한 번의 추론으로 따라잡는다 (마감은 가장 이른 것 유지)
+    Eigen::Index max_samples = static_cast<Eigen::Index>(options.max_coalesce_seconds * options.sample_rate);
+    auto start_time = job.metadata.find("start_time");  // 합친 오디오는 첫 청크 시각에 시작한다
+    std::any first_start = start_time != job.metadata.end() ? start_time->second : std::any();
+    while (!session.pending.empty() &&
+           job.audio.size() + session.pending.front().audio.size() <= max_samples) {
+        Job& next = session.pending.front();
+        AudioTensor merged(job.audio.size() + next.audio.size());
+        merged << job.audio, next.audio;
+        job.audio.swap(merged);
+        job.metadata = std::move(next.metadata);
+        session.pending.pop_front();
+        session.stats.coalesced++;
+    }
+    job.metadata["duration"] = static_cast<float>(job.audio.size()) / static_cast<float>(options.sample_rate);
+    if (first_start.has_value()) {
+        job.metadata["start_time"] = std::move(first_start);
+    }
+}
+
+void InferenceScheduler::RecordCompletion(Session& session, const Job& job, Clock::time_point finished) {
+    double time_to_score = std::chrono::duration<double>(finished - job.arrival).count();
+    double lateness = std::chrono::duration<double>(finished - job.deadline).count();
+
+    session.stats.completed++;
+    session.total_time_to_score += time_to_score;
+    if (lateness > 0.0) {
+        session.stats.late++;
+        session.stats.max_lateness = std::max(session.stats.max_lateness, lateness);
+    }
+
+    if (session.recent.size() < kRecentSamples) {
+        session.recent.push_back(time_to_score);
+    } else {
+        session.recent[session.recent_next] = time_to_score;
+    }
+    session.recent_next = (session.recent_next + 1) % kRecentSamples;
+}
+
+void InferenceScheduler::WorkerLoop() {
+    Clock::duration drop_after = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(options.drop_after_seconds));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_cv.wait(lock, [this]() { return stopping || !ready.empty(); });
+        if (stopping) {
+            return;
+        }
+
+        ReadyEntry entry = ready.top();
+        ready.pop();
+
+        auto it = sessions.find(entry.id);
+        if (it == sessions.end()) {
+            continue;
+        }
+        std::shared_ptr<Session> session = it->second;
+        session->queued = false;
+        if (session->pending.empty()) {
+            continue;  // Cancel된 세션
+        }
+
+        Job job = std::move(session->pending.front());
+        session->pending.pop_front();
+
+        Clock::time_point now = Clock::now();
+        if (now > job.deadline) {
+            if (drop_after > Clock::duration::zero() && now - job.deadline > drop_after) {
+                session->stats.dropped++;
+                MakeReady(entry.id, *session);
+                idle_cv.notify_all();
+                continue;
+            }
+            Coalesce(*session, job);
+        }
+
+        session->running = true;
+        lock.unlock();
+
+        try {
+            session->handler(job.audio, job.metadata);
+        } catch (const std::exception& e) {
+            LOG_ERROR("InferenceScheduler", "청크 작업 오류: " + std::string(e.what()));
+        }
+
+        Clock::time_point finished = Clock::now();
+        lock.lock();
+        session->running = false;
+        RecordCompletion(*session, job, finished);
+        if (!session->removed) {
+            MakeReady(entry.id, *session);
+            if (session->queued) {
+                work_cv.notify_one();
+            }
+        }
+        idle_cv.notify_all();
+    }
+}
+
+} // namespace realtime_engine_ko
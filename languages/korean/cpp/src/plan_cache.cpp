@@ -0,0 +1,342 @@
+// src/cpp/src/plan_cache.cpp
+#include "realtime_engine_ko/plan_cache.h"
+#include "realtime_engine_ko/w2v_onnx_core.h"
+#include "realtime_engine_ko/sentence_block.h"
+#include "realtime_engine_ko/common.h"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+constexpr char kStoreMagic[4] = {'R', 'K', 'P', 'C'};
+constexpr uint32_t kStoreFormat = 1;
+
+void PutU32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out += static_cast<char>((value >> shift) & 0xFF);
+    }
+}
+
+void PutString(std::string& out, const std::string& value) {
+    PutU32(out, static_cast<uint32_t>(value.size()));
+    out += value;
+}
+
+void PutIds(std::string& out, const std::vector<int>& ids) {
+    PutU32(out, static_cast<uint32_t>(ids.size()));
+    for (int id : ids) {
+        PutU32(out, static_cast<uint32_t>(id));
+    }
+}
+
+// mmap된 저장소를 경계 검사하며 읽는다. 잘린 파일이면 std::runtime_error
+class StoreReader {
+public:
+    StoreReader(const char* data, size_t size) : data(data), size(size) {}
+
+    uint32_t U32() {
+        Require(4);
+        const auto* p = reinterpret_cast<const unsigned char*>(data + offset);
+        offset += 4;
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    std::string String() {
+        uint32_t length = U32();
+        Require(length);
+        std::string value(data + offset, length);
+        offset += length;
+        return value;
+    }
+
+    std::vector<int> Ids(int vocab_size) {
+        uint32_t count = U32();
+        Require(static_cast<size_t>(count) * 4);
+        std::vector<int> ids(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            ids[i] = static_cast<int32_t>(U32());
+            if (ids[i] < 0 || ids[i] >= vocab_size) {
+                throw std::runtime_error("어휘 범위를 벗어난 토큰 ID");
+            }
+        }
+        return ids;
+    }
+
+    const char* Bytes(size_t length) {
+        Require(length);
+        const char* p = data + offset;
+        offset += length;
+        return p;
+    }
+
+private:
+    void Require(size_t length) const {
+        if (length > size - offset) {
+            throw std::runtime_error("저장소 파일이 잘렸습니다");
+        }
+    }
+
+    const char* data;
+    size_t size;
+    size_t offset = 0;
+};
+
+} // namespace
+
+PlanCache::PlanCache() : PlanCache(Options()) {
+}
+
+PlanCache::PlanCache(const Options& options) : options(options) {
+}
+
+std::shared_ptr<PlanCache> PlanCache::Global() {
+    static std::shared_ptr<PlanCache> instance = std::make_shared<PlanCache>();
+    return instance;
+}
+
+void PlanCache::SetMaxBytes(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    options.max_bytes = max_bytes;
+    EvictLocked();
+}
+
+std::string PlanCache::MakeKey(const std::string& model_version, const std::string& sentence) {
+    std::string key;
+    key.reserve(model_version.size() + 1 + sentence.size());
+    key += model_version;
+    key += '\0';
+    key += sentence;
+    return key;
+}
+
+std::shared_ptr<const SentencePlan> PlanCache::GetOrCompile(
+    Wav2VecCTCOnnxCore& engine,
+    const std::string& sentence) {
+
+    std::string key = MakeKey(engine.ModelVersion(), sentence);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+            hits++;
+            return it->second->plan;
+        }
+        misses++;
+    }
+
+    // 컴파일은 잠금 밖에서 (토크나이저 호출이 다른 세션의 캐시 조회를 막지 않도록)
+    auto plan = SentencePlan::Compile(engine, SentenceBlockManager::SplitBlocks(sentence));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // 다른 세션이 먼저 넣었으면 그것을 공유한다
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->plan;
+    }
+
+    Entry entry;
+    entry.key = std::move(key);
+    entry.model_version = engine.ModelVersion();
+    entry.sentence = sentence;
+    entry.bytes = plan->MemoryBytes() + entry.key.capacity() + entry.sentence.capacity();
+    entry.plan = plan;
+    InsertLocked(std::move(entry));
+    return plan;
+}
+
+void PlanCache::InsertLocked(Entry entry) {
+    auto existing = index.find(entry.key);
+    if (existing != index.end()) {
+        total_bytes -= existing->second->bytes;
+        lru.erase(existing->second);
+        index.erase(existing);
+    }
+
+    // 상한보다 큰 계획은 캐시하지 않는다 (호출자는 반환된 계획을 그대로 쓴다)
+    if (entry.bytes > options.max_bytes) {
+        return;
+    }
+
+    total_bytes += entry.bytes;
+    lru.push_front(std::move(entry));
+    index[lru.front().key] = lru.begin();
+    EvictLocked();
+}
+
+void PlanCache::EvictLocked() {
+    while (total_bytes > options.max_bytes && !lru.empty()) {
+        total_bytes -= lru.back().bytes;
+        index.erase(lru.back().key);
+        lru.pop_back();
+        evictions++;
+    }
+}
+
+size_t PlanCache::Preload(Wav2VecCTCOnnxCore& engine, const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_INFO("PlanCache", "문장 계획 저장소 없음: " + path);
+        return 0;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return 0;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        LOG_ERROR("PlanCache", "문장 계획 저장소 mmap 실패: " + path);
+        return 0;
+    }
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+
+    size_t loaded = 0;
+    try {
+        StoreReader reader(static_cast<const char*>(mapped), size);
+        if (std::memcmp(reader.Bytes(sizeof(kStoreMagic)), kStoreMagic, sizeof(kStoreMagic)) != 0 ||
+            reader.U32() != kStoreFormat) {
+            throw std::runtime_error("알 수 없는 저장소 형식");
+        }
+
+        std::string model_version = reader.String();
+        if (model_version != engine.ModelVersion()) {
+            LOG_INFO("PlanCache", "모델 버전이 달라 저장소를 건너뜀: " + model_version +
+                     " != " + engine.ModelVersion());
+            ::munmap(mapped, size);
+            return 0;
+        }
+
+        const int vocab_size = engine.VocabSize();
+        uint32_t num_entries = reader.U32();
+        for (uint32_t e = 0; e < num_entries; ++e) {
+            std::string sentence = reader.String();
+            uint32_t num_blocks = reader.U32();
+
+            std::vector<std::string> block_texts;
+            std::vector<std::vector<int>> context_ids;
+            std::vector<std::vector<int>> target_ids;
+            std::vector<std::pair<int, int>> target_words;
+            for (uint32_t b = 0; b < num_blocks; ++b) {
+                block_texts.push_back(reader.String());
+                int word_index = static_cast<int32_t>(reader.U32());
+                int word_count = static_cast<int32_t>(reader.U32());
+                target_words.emplace_back(word_index, word_count);
+                context_ids.push_back(reader.Ids(vocab_size));
+                target_ids.push_back(reader.Ids(vocab_size));
+            }
+
+            auto plan = SentencePlan::FromTokenIds(engine, block_texts, context_ids, target_ids, target_words);
+
+            Entry entry;
+            entry.key = MakeKey(model_version, sentence);
+            entry.model_version = model_version;
+            entry.sentence = std::move(sentence);
+            entry.bytes = plan->MemoryBytes() + entry.key.capacity() + entry.sentence.capacity();
+            entry.plan = std::move(plan);
+
+            // 파일은 오래된 항목부터 저장되어 있으므로 순서대로 넣으면 LRU 순서가 복원된다
+            std::lock_guard<std::mutex> lock(mutex);
+            InsertLocked(std::move(entry));
+            loaded++;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("PlanCache", "문장 계획 저장소 읽기 오류 (" + path + "): " + e.what());
+    }
+
+    ::munmap(mapped, size);
+
+    std::stringstream ss;
+    ss << "문장 계획 " << loaded << "개 적재: " << path;
+    LOG_INFO("PlanCache", ss.str());
+    return loaded;
+}
+
+size_t PlanCache::Save(const Wav2VecCTCOnnxCore& engine, const std::string& path) const {
+    const std::string& model_version = engine.ModelVersion();
+
+    // 잠금은 항목 목록 복사 동안만 (계획은 불변이라 잠금 밖에서 직렬화해도 된다)
+    std::vector<std::pair<std::string, std::shared_ptr<const SentencePlan>>> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.reserve(lru.size());
+        for (auto it = lru.rbegin(); it != lru.rend(); ++it) {
+            if (it->model_version == model_version) {
+                entries.emplace_back(it->sentence, it->plan);
+            }
+        }
+    }
+
+    std::string out;
+    out.append(kStoreMagic, sizeof(kStoreMagic));
+    PutU32(out, kStoreFormat);
+    PutString(out, model_version);
+    PutU32(out, static_cast<uint32_t>(entries.size()));
+    for (const auto& [sentence, plan] : entries) {
+        PutString(out, sentence);
+        PutU32(out, static_cast<uint32_t>(plan->blocks.size()));
+        for (size_t b = 0; b < plan->blocks.size(); ++b) {
+            const BlockPlan& block = plan->blocks[b];
+            PutString(out, plan->block_texts[b]);
+            PutU32(out, static_cast<uint32_t>(block.target_word_index));
+            PutU32(out, static_cast<uint32_t>(block.target_word_count));
+            PutIds(out, block.context_tokens.ids);
+            PutIds(out, block.target_tokens.ids);
+        }
+    }
+
+    // 다른 프로세스가 읽는 중일 수 있으므로 임시 파일에 쓰고 rename
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            LOG_ERROR("PlanCache", "문장 계획 저장소 쓰기 실패: " + tmp_path);
+            return 0;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG_ERROR("PlanCache", "문장 계획 저장소 rename 실패: " + path);
+        std::remove(tmp_path.c_str());
+        return 0;
+    }
+
+    std::stringstream ss;
+    ss << "문장 계획 " << entries.size() << "개 저장: " << path;
+    LOG_INFO("PlanCache", ss.str());
+    return entries.size();
+}
+
+PlanCache::Stats PlanCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.evictions = evictions;
+    stats.entries = lru.size();
+    stats.bytes = total_bytes;
+    return stats;
+}
+
+void PlanCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+    total_bytes = 0;
+}
+
+} // namespace realtime_engine_ko
@@ -8,6 +8,7 @@ namespace realtime_engine_ko {
 
 ProgressTracker::ProgressTracker(int total_blocks, int window_size, bool time_based_advance)
     : total_blocks(total_blocks), window_size(window_size), time_based_advance(time_based_advance),
+      adaptive_window(std::max(1, window_size)),
       current_index(0), start_time(std::nullopt), last_advance_time(std::nullopt),
       avg_time_per_block(2.0), min_time_for_advance(1.5) {
     
@@ -47,7 +48,7 @@ double ProgressTracker::GetTimeSinceLastAdvance() const {
 }
 
 std::vector<int> ProgressTracker::GetActiveWindow() const {
-    int start = std::max(0, current_index - window_size + 1);
+    int start = std::max(0, current_index - adaptive_window + 1);
     int end = current_index + 1;
     
     std::vector<int> result;
@@ -64,6 +65,15 @@ int ProgressTracker::GetExpectedBlockIndex() const {
     }
     
     double elapsed = GetElapsedTime();
+    
+    // 음절 속도를 알면 블록 길이를 반영해 누적 음절 시간으로 위치를 추정
+    if (seconds_per_syllable > 0.0 && cumulative_syllables.size() == static_cast<size_t>(total_blocks) + 1) {
+        double spoken_syllables = elapsed / seconds_per_syllable;
+        auto it = std::upper_bound(cumulative_syllables.begin() + 1, cumulative_syllables.end(), spoken_syllables);
+        int expected_index = static_cast<int>(it - (cumulative_syllables.begin() + 1));
+        return std::min(expected_index, total_blocks - 1);
+    }
+    
     int expected_index = std::min(
         static_cast<int>(elapsed / avg_time_per_block),
         total_blocks - 1
@@ -124,6 +134,9 @@ void ProgressTracker::Reset() {
     current_index = 0;
     start_time = std::nullopt;
     last_advance_time = std::nullopt;
+    last_observation_time = std::nullopt;
+    adaptive_window = std::max(1, window_size);
+    on_track_streak = 0;
     
     LOG_INFO("ProgressTracker", "진행 상태 초기화");
 }
@@ -143,4 +156,69 @@ void ProgressTracker::AdjustTimeParameters(double avg_time_per_block, double min
     LOG_INFO("ProgressTracker", ss.str());
 }
 
+void ProgressTracker::SetBlockSyllables(const std::vector<int>& syllables) {
+    cumulative_syllables.clear();
+    if (syllables.size() != static_cast<size_t>(total_blocks)) {
+        return;
+    }
+    
+    cumulative_syllables.reserve(syllables.size() + 1);
+    cumulative_syllables.push_back(0);
+    for (int count : syllables) {
+        cumulative_syllables.push_back(cumulative_syllables.back() + std::max(1, count));
+    }
+}
+
+void ProgressTracker::ObserveEvaluation(int block_id, bool on_track) {
+    auto now = std::chrono::system_clock::now();
+    auto previous = last_observation_time.has_value() ? last_observation_time : start_time;
+    last_observation_time = now;
+    
+    if (!on_track) {
+        // 순서가 어긋난 발화: 어디를 읽는지 불확실하므로 윈도우를 최대로
+        on_track_streak = 0;
+        adaptive_window = std::max(1, window_size);
+        return;
+    }
+    
+    // 기대 블록 하나를 읽은 시간으로 블록/음절 속도 지수 평균 갱신 (긴 휴지는 잘라서 반영)
+    if (previous.has_value()) {
+        double seconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - previous.value()).count() / 1000.0;
+        seconds = std::clamp(seconds, 0.1, 4.0 * avg_time_per_block);
+        avg_time_per_block += kRateSmoothing * (seconds - avg_time_per_block);
+        
+        if (block_id >= 0 && block_id + 1 < static_cast<int>(cumulative_syllables.size())) {
+            int syllables = cumulative_syllables[block_id + 1] - cumulative_syllables[block_id];
+            double sample = seconds / syllables;
+            seconds_per_syllable = seconds_per_syllable > 0.0
+                ? seconds_per_syllable + kRateSmoothing * (sample - seconds_per_syllable)
+                : sample;
+        }
+    }
+    
+    // 기대 블록이 연속으로 맞으면 현재 블록 하나만 채점
+    if (++on_track_streak >= kOnTrackStreakToShrink && adaptive_window != 1) {
+        adaptive_window = 1;
+        
+        if (LogEnabled(LogLevel::DEBUG)) {
+            std::stringstream ss;
+            ss << "윈도우 축소: 1 블록 (블록당 " << avg_time_per_block << "초, 음절당 " << seconds_per_syllable << "초)";
+            LOG_DEBUG("ProgressTracker", ss.str());
+        }
+    }
+}
+
+void ProgressTracker::ObserveMiss() {
+    on_track_streak = 0;
+    if (adaptive_window < window_size) {
+        adaptive_window++;
+        
+        if (LogEnabled(LogLevel::DEBUG)) {
+            std::stringstream ss;
+            ss << "윈도우 확장: " << adaptive_window << " 블록";
+            LOG_DEBUG("ProgressTracker", ss.str());
+        }
+    }
+}
+
 } // namespace realtime_engine_ko
\ No newline at end of file
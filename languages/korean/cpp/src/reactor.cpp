@@ -0,0 +1,290 @@
+// src/cpp/src/reactor.cpp
+#include "realtime_engine_ko/reactor.h"
+#include "realtime_engine_ko/common.h"
+#include <algorithm>
+#include <sstream>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+
+// 현재 작업자에서 실행 중인 등록 (Remove가 자기 콜백 안에서 불렸는지 판별)
+thread_local const void* current_entry = nullptr;
+
+size_t ResolveThreads(size_t num_threads) {
+    return num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::mutex shared_mutex;
+std::shared_ptr<Reactor> shared_reactor;  // shared_mutex 보호
+
+} // namespace
+
+std::shared_ptr<Reactor> Reactor::Shared() {
+    std::lock_guard<std::mutex> lock(shared_mutex);
+    return shared_reactor;
+}
+
+void Reactor::SetShared(std::shared_ptr<Reactor> reactor) {
+    // 이전 Reactor는 마지막 사용 세션이 놓을 때 소멸한다
+    std::lock_guard<std::mutex> lock(shared_mutex);
+    shared_reactor = std::move(reactor);
+}
+
+Reactor::Reactor() : Reactor(Options()) {
+}
+
+Reactor::Reactor(const Options& options) : options(options), pool(ResolveThreads(options.num_threads)) {
+    epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        if (epoll_fd >= 0) ::close(epoll_fd);
+        if (wake_fd >= 0) ::close(wake_fd);
+        throw std::runtime_error("Reactor: epoll/eventfd 생성 실패: " + std::string(std::strerror(errno)));
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = 0;  // 0은 종료 신호 (등록 핸들은 1부터)
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+
+    running = true;
+    loop_thread = std::make_unique<std::thread>(&Reactor::EventLoop, this);
+
+    std::stringstream ss;
+    ss << "Reactor 시작: 작업자 " << pool.Size() << "개";
+    LOG_INFO("Reactor", ss.str());
+}
+
+Reactor::~Reactor() {
+    running = false;
+    uint64_t one = 1;
+    if (::write(wake_fd, &one, sizeof(one)) < 0) {
+        LOG_ERROR("Reactor", "종료 신호 쓰기 실패");
+    }
+    if (loop_thread && loop_thread->joinable()) {
+        loop_thread->join();
+    }
+
+    // 남은 등록을 정리한다 (풀은 멤버 소멸 시 대기 작업을 끝내고 종료)
+    std::unordered_map<Handle, std::shared_ptr<Entry>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(entries_mutex);
+        remaining.swap(entries);
+    }
+    for (auto& [handle, entry] : remaining) {
+        std::lock_guard<std::mutex> run_lock(entry->run_mutex);
+        entry->removed = true;
+        for (int fd : entry->fds) {
+            ::close(fd);
+        }
+    }
+
+    ::close(wake_fd);
+    ::close(epoll_fd);
+}
+
+int Reactor::CreateTimerFd(double interval_seconds) {
+    int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // 0 간격은 timerfd를 끄므로 최소 1ms
+    double seconds = std::max(interval_seconds, 0.001);
+    itimerspec spec{};
+    spec.it_interval.tv_sec = static_cast<time_t>(seconds);
+    spec.it_interval.tv_nsec = static_cast<long>((seconds - std::floor(seconds)) * 1e9);
+    spec.it_value = spec.it_interval;
+    if (::timerfd_settime(fd, 0, &spec, nullptr) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+Reactor::Handle Reactor::Register(std::shared_ptr<Entry> entry) {
+    std::lock_guard<std::mutex> lock(entries_mutex);
+    Handle handle = next_handle++;
+
+    for (int fd : entry->fds) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = handle;
+        if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            LOG_ERROR("Reactor", "epoll 등록 실패: " + std::string(std::strerror(errno)));
+            for (int added : entry->fds) {
+                ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, added, nullptr);
+                ::close(added);
+            }
+            return 0;
+        }
+    }
+
+    entries.emplace(handle, std::move(entry));
+    return handle;
+}
+
+Reactor::Handle Reactor::AddTimer(double interval_seconds, Callback callback) {
+    int fd = CreateTimerFd(interval_seconds);
+    if (fd < 0) {
+        LOG_ERROR("Reactor", "timerfd 생성 실패: " + std::string(std::strerror(errno)));
+        return 0;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->callback = std::move(callback);
+    entry->fds.push_back(fd);
+    return Register(std::move(entry));
+}
+
+Reactor::Handle Reactor::AddFileWatch(const std::string& path, double poll_interval_seconds, Callback callback) {
+    auto entry = std::make_shared<Entry>();
+    entry->callback = std::move(callback);
+
+    // 감시 하나당 inotify 인스턴스 하나 (fd가 곧 등록이므로 이벤트 내용은 읽어 버리기만 한다)
+    int inotify_fd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (inotify_fd >= 0 && ::inotify_add_watch(inotify_fd, path.c_str(), IN_MODIFY | IN_CLOSE_WRITE) >= 0) {
+        entry->fds.push_back(inotify_fd);
+        // 쓰기는 IN_MODIFY로 바로 깨우므로 주기 확인은 놓친 이벤트를 줍는 용도로만 드물게 한다
+        if (poll_interval_seconds > 0.0) {
+            poll_interval_seconds = options.watched_poll_interval > 0.0
+                ? std::max(poll_interval_seconds, options.watched_poll_interval)
+                : 0.0;
+        }
+    } else {
+        if (inotify_fd >= 0) {
+            ::close(inotify_fd);
+        }
+        LOG_WARNING("Reactor", "inotify 감시 실패, 주기 확인만 사용: " + path);
+    }
+
+    if (poll_interval_seconds > 0.0) {
+        int timer_fd = CreateTimerFd(poll_interval_seconds);
+        if (timer_fd >= 0) {
+            entry->fds.push_back(timer_fd);
+        }
+    }
+
+    if (entry->fds.empty()) {
+        LOG_ERROR("Reactor", "파일 감시 등록 실패: " + path);
+        return 0;
+    }
+    return Register(std::move(entry));
+}
+
+void Reactor::Remove(Handle handle) {
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(entries_mutex);
+        auto it = entries.find(handle);
+        if (it == entries.end()) {
+            return;
+        }
+        entry = std::move(it->second);
+        entries.erase(it);
+
+        // 루프가 이미 꺼낸 이벤트는 핸들 조회에서 걸러진다
+        for (int fd : entry->fds) {
+            ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            ::close(fd);
+        }
+    }
+
+    // 자기 콜백 안에서의 호출이면 이미 run_mutex를 잡고 있다
+    if (current_entry == entry.get()) {
+        entry->removed = true;
+        return;
+    }
+    std::lock_guard<std::mutex> run_lock(entry->run_mutex);
+    entry->removed = true;
+}
+
+void Reactor::EventLoop() {
+    epoll_event events[kMaxEvents];
+    char drain[4096];
+
+    while (running) {
+        int ready = ::epoll_wait(epoll_fd, events, kMaxEvents, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("Reactor", "epoll_wait 오류: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            Handle handle = events[i].data.u64;
+            if (handle == 0) {
+                continue;  // 종료 신호
+            }
+
+            std::shared_ptr<Entry> entry;
+            {
+                std::lock_guard<std::mutex> lock(entries_mutex);
+                auto it = entries.find(handle);
+                if (it == entries.end()) {
+                    continue;
+                }
+                entry = it->second;
+
+                // 레벨 트리거이므로 fd를 비워 둔다 (timerfd 만료 횟수/inotify 이벤트는 쓰지 않는다)
+                for (int fd : entry->fds) {
+                    while (::read(fd, drain, sizeof(drain)) > 0) {
+                    }
+                }
+            }
+            Dispatch(entry);
+        }
+    }
+}
+
+void Reactor::Dispatch(const std::shared_ptr<Entry>& entry) {
+    entry->rerun = true;
+    if (entry->queued.exchange(true)) {
+        return;  // 실행 중이거나 대기 중: 끝난 뒤 한 번 더 실행된다
+    }
+
+    try {
+        pool.Submit([this, entry]() { Run(entry); });
+    } catch (const std::exception& e) {
+        entry->queued = false;
+        LOG_ERROR("Reactor", "콜백 제출 실패: " + std::string(e.what()));
+    }
+}
+
+void Reactor::Run(const std::shared_ptr<Entry>& entry) {
+    std::lock_guard<std::mutex> lock(entry->run_mutex);
+    current_entry = entry.get();
+    for (;;) {
+        entry->rerun = false;
+        if (!entry->removed) {
+            try {
+                entry->callback();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Reactor", "콜백 오류: " + std::string(e.what()));
+            }
+        }
+        entry->queued = false;
+
+        // 실행 중에 도착한 이벤트는 한 번의 재실행으로 합친다 (그 사이 다른 작업이 잡았으면 그쪽이 실행)
+        if (!entry->rerun || entry->queued.exchange(true)) {
+            break;
+        }
+    }
+    current_entry = nullptr;
+}
+
+} // namespace realtime_engine_ko
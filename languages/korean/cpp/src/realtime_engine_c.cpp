@@ -3,7 +3,6 @@
 #include "realtime_engine_ko/recognition_engine.h"
 #include <string>
 #include <cstring>
-#include <nlohmann/json.hpp>
 
 using namespace realtime_engine_ko;
 
@@ -14,36 +13,10 @@ static char* copy_string(const std::string& str) {
     return result;
 }
 
-// JSON으로 변환 헬퍼 함수
-static char* convert_to_json(const std::map<std::string, std::any>& map_data) {
-    nlohmann::json json_data;
-    
-    for (const auto& [key, value] : map_data) {
-        try {
-            if (value.type() == typeid(std::string)) {
-                json_data[key] = std::any_cast<std::string>(value);
-            } 
-            else if (value.type() == typeid(int)) {
-                json_data[key] = std::any_cast<int>(value);
-            }
-            else if (value.type() == typeid(float)) {
-                json_data[key] = std::any_cast<float>(value);
-            }
-            else if (value.type() == typeid(double)) {
-                json_data[key] = std::any_cast<double>(value);
-            }
-            else if (value.type() == typeid(bool)) {
-                json_data[key] = std::any_cast<bool>(value);
-            }
-            // 다른 타입들은 필요에 따라 추가
-        } 
-        catch (const std::bad_any_cast&) {
-            json_data[key] = nullptr;
-        }
-    }
-    
-    std::string json_str = json_data.dump();
-    return copy_string(json_str);
+// 스레드별 재사용 JSON 버퍼 (DOM 없이 상태 전체를 직렬화)
+static ResultJsonWriter& json_writer() {
+    thread_local ResultJsonWriter writer;
+    return writer;
 }
 
 extern "C" {
@@ -100,6 +73,60 @@ void engine_set_listener(
     reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->SetRecordListener(listener);
 }
 
+void engine_set_listener_binary(
+    EngineCoordinatorHandle handle,
+    StartCallbackFn on_start,
+    TickCallbackFn on_tick,
+    FailCallbackFn on_fail,
+    EndCallbackFn on_end,
+    BinaryScoreCallbackFn on_score)
+{
+    if (!handle) return;
+    
+    std::function<void()> start_fn = on_start ? 
+        [on_start]() { on_start(); } : std::function<void()>();
+        
+    std::function<void(int, int)> tick_fn = on_tick ? 
+        [on_tick](int current, int total) { on_tick(current, total); } : std::function<void(int, int)>();
+        
+    std::function<void(const std::string&)> fail_fn = on_fail ? 
+        [on_fail](const std::string& msg) { on_fail(msg.c_str()); } : std::function<void(const std::string&)>();
+        
+    std::function<void()> end_fn = on_end ? 
+        [on_end]() { on_end(); } : std::function<void()>();
+        
+    std::function<void(const std::string&)> score_fn = on_score ? 
+        [on_score](const std::string& data) {
+            on_score(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        } : std::function<void(const std::string&)>();
+    
+    RecordListener listener(start_fn, tick_fn, fail_fn, end_fn, score_fn);
+    
+    auto* coordinator = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle);
+    coordinator->SetResultEncoding(ResultEncoding::MSGPACK);
+    coordinator->SetRecordListener(listener);
+}
+
+void engine_set_result_encoding(EngineCoordinatorHandle handle, int encoding)
+{
+    if (!handle) return;
+    reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->SetResultEncoding(
+        encoding == ENGINE_RESULT_ENCODING_MSGPACK ? ResultEncoding::MSGPACK : ResultEncoding::JSON);
+}
+
+void engine_set_score_mode(EngineCoordinatorHandle handle, bool delta)
+{
+    if (!handle) return;
+    reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->SetScoreEventMode(
+        delta ? ScoreEventMode::DELTA : ScoreEventMode::FULL);
+}
+
+void engine_request_snapshot(EngineCoordinatorHandle handle)
+{
+    if (!handle) return;
+    reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->RequestSnapshot();
+}
+
 bool engine_initialize(
     EngineCoordinatorHandle handle,
     const char* sentence,
@@ -137,8 +164,8 @@ void engine_reset(EngineCoordinatorHandle handle)
 const char* engine_get_results(EngineCoordinatorHandle handle)
 {
     if (!handle) return nullptr;
-    auto results = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->GetResults();
-    return convert_to_json(results);
+    auto state = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->GetState();
+    return copy_string(json_writer().Write(state));
 }
 
 const char* engine_evaluate_speech(
@@ -149,13 +176,123 @@ const char* engine_evaluate_speech(
     if (!handle) return nullptr;
     
     RecordListener empty_listener;
-    auto results = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->EvaluateSpeech(
+    auto state = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->EvaluateSpeechState(
+        sentence, 
+        audio_file_path,
+        empty_listener
+    );
+    
+    return copy_string(json_writer().Write(state));
+}
+
+bool engine_evaluate_speech_async(
+    EngineCoordinatorHandle handle,
+    const char* sentence,
+    const char* audio_file_path,
+    CompletionCallbackFn on_complete,
+    void* user_data)
+{
+    if (!handle) return false;
+    
+    CompletionCallback complete_fn = on_complete ?
+        [on_complete, user_data](const EngineState& state) {
+            on_complete(json_writer().Write(state).c_str(), user_data);
+        } : CompletionCallback();
+    
+    RecordListener empty_listener;
+    auto future = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->EvaluateSpeechAsync(
+        sentence,
+        audio_file_path,
+        empty_listener,
+        complete_fn
+    );
+    
+    // 시작에 실패했으면 이미 완료되어 있다 (시작 직후 문장이 끝났을 수도 있으므로 status로 구분)
+    if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return true;
+    }
+    const std::string status = future.get().status;
+    return status != "busy" && status != "initialization_failed" && status != "start_failed";
+}
+
+void engine_cancel_evaluation(EngineCoordinatorHandle handle)
+{
+    if (!handle) return;
+    reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->CancelEvaluation();
+}
+
+const char* engine_get_metrics(EngineCoordinatorHandle handle)
+{
+    auto snapshot = handle
+        ? reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->GetMetrics()
+        : StageMetrics::Global().GetSnapshot();
+    return copy_string(MetricsToJson(snapshot));
+}
+
+const char* engine_get_metrics_prometheus(EngineCoordinatorHandle handle, const char* session_label)
+{
+    std::string session = session_label ? session_label : "";
+    if (!handle) {
+        return copy_string(MetricsToPrometheus(StageMetrics::Global().GetSnapshot(), "process", session));
+    }
+    auto snapshot = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->GetMetrics();
+    return copy_string(MetricsToPrometheus(snapshot, "session", session));
+}
+
+int engine_set_shared_reactor(int num_threads)
+{
+    if (num_threads < 0) {
+        Reactor::SetShared(nullptr);
+        return 1;
+    }
+    try {
+        Reactor::Options options;
+        options.num_threads = static_cast<size_t>(num_threads);
+        Reactor::SetShared(std::make_shared<Reactor>(options));
+        return 1;
+    } catch (const std::exception& e) {
+        return 0;
+    }
+}
+
+void engine_set_log_level(int level)
+{
+    using realtime_engine_ko::LogLevel;
+    if (level < static_cast<int>(LogLevel::DEBUG)) level = static_cast<int>(LogLevel::DEBUG);
+    if (level > static_cast<int>(LogLevel::ERROR)) level = static_cast<int>(LogLevel::ERROR);
+    realtime_engine_ko::SetLogLevel(static_cast<LogLevel>(level));
+}
+
+void engine_flush_logs(void)
+{
+    realtime_engine_ko::FlushLogs();
+}
+
+const uint8_t* engine_get_results_binary(EngineCoordinatorHandle handle, size_t* size)
+{
+    if (!handle) return nullptr;
+    const std::string& buffer = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->GetResultsBinary();
+    if (size) *size = buffer.size();
+    return reinterpret_cast<const uint8_t*>(buffer.data());
+}
+
+const uint8_t* engine_evaluate_speech_binary(
+    EngineCoordinatorHandle handle,
+    const char* sentence,
+    const char* audio_file_path,
+    size_t* size)
+{
+    if (!handle) return nullptr;
+    
+    RecordListener empty_listener;
+    const std::string& buffer = reinterpret_cast<realtime_engine_ko::EngineCoordinator*>(handle)->EvaluateSpeechBinary(
         sentence, 
         audio_file_path,
         empty_listener
     );
     
-    return convert_to_json(results);
+    if (size) *size = buffer.size();
+    return reinterpret_cast<const uint8_t*>(buffer.data());
 }
 
 void engine_destroy(EngineCoordinatorHandle handle)
@@ -1,9 +1,14 @@
 // src/cpp/src/recognition_engine.cpp
 #include "realtime_engine_ko/recognition_engine.h"
 #include "realtime_engine_ko/common.h"
+#include "realtime_engine_ko/thread_pool.h"
 #include <sstream>
+#include <future>
+#include <numeric>
 #include <chrono>
 #include <thread>
+#include <ctime>
+#include <fstream>
 #include <nlohmann/json.hpp>
 
 namespace realtime_engine_ko {
@@ -19,6 +24,43 @@ RecordListener::RecordListener(
       on_record_end(on_record_end), on_score(on_score) {
 }
 
+nlohmann::json ResultMapToJson(const std::map<std::string, std::any>& map) {
+    nlohmann::json json = nlohmann::json::object();
+    
+    for (const auto& [key, value] : map) {
+        try {
+            if (value.type() == typeid(int)) {
+                json[key] = std::any_cast<int>(value);
+            } else if (value.type() == typeid(float)) {
+                json[key] = std::any_cast<float>(value);
+            } else if (value.type() == typeid(double)) {
+                json[key] = std::any_cast<double>(value);
+            } else if (value.type() == typeid(bool)) {
+                json[key] = std::any_cast<bool>(value);
+            } else if (value.type() == typeid(std::string)) {
+                json[key] = std::any_cast<std::string>(value);
+            } else if (value.type() == typeid(size_t)) {
+                json[key] = std::any_cast<size_t>(value);
+            } else if (value.type() == typeid(std::time_t)) {
+                json[key] = std::any_cast<std::time_t>(value);
+            } else if (value.type() == typeid(std::vector<std::map<std::string, std::any>>)) {
+                const auto& vec = std::any_cast<const std::vector<std::map<std::string, std::any>>&>(value);
+                nlohmann::json json_array = nlohmann::json::array();
+                for (const auto& item : vec) {
+                    json_array.push_back(ResultMapToJson(item));
+                }
+                json[key] = std::move(json_array);
+            } else if (value.type() == typeid(std::map<std::string, std::any>)) {
+                json[key] = ResultMapToJson(std::any_cast<const std::map<std::string, std::any>&>(value));
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("EngineCoordinator", "JSON 변환 오류: " + std::string(e.what()));
+        }
+    }
+    
+    return json;
+}
+
 // EngineCoordinator 구현
 EngineCoordinator::EngineCoordinator(
     const std::string& onnx_model_path,
@@ -28,8 +70,15 @@ EngineCoordinator::EngineCoordinator(
     float confidence_threshold)
     : is_initialized(false), is_running(false),
       update_interval(update_interval), confidence_threshold(confidence_threshold),
-      timer_thread(nullptr) {
+      timer_thread(nullptr), result_encoding(ResultEncoding::JSON),
+      score_event_mode(ScoreEventMode::FULL), snapshot_requested(true), score_seq(0),
+      scheduler_session(0), schedule_chunks(false), reactor(Reactor::Shared()), tick_timer(0), file_watch(0),
+      plan_cache(PlanCache::Global()),
+      candidate_margin(EvaluationController::kDefaultCandidateMargin),
+      alignment_mode(AlignmentMode::WINDOW),
+      evaluation_cancelled(false), resident_blocks(0) {
     
+    state_snapshot = std::make_shared<const EngineState>(BuildState());
     try {
         // 인식 엔진 초기화 (unique_ptr 대신 shared_ptr 사용)
         recognition_engine = std::make_shared<Wav2VecCTCOnnxCore>(
@@ -44,34 +93,201 @@ EngineCoordinator::EngineCoordinator(
     }
 }
 
+EngineCoordinator::EngineCoordinator(
+    std::shared_ptr<Wav2VecCTCOnnxCore> recognition_engine,
+    float update_interval,
+    float confidence_threshold)
+    : recognition_engine(std::move(recognition_engine)),
+      is_initialized(false), is_running(false),
+      update_interval(update_interval), confidence_threshold(confidence_threshold),
+      timer_thread(nullptr), result_encoding(ResultEncoding::JSON),
+      score_event_mode(ScoreEventMode::FULL), snapshot_requested(true), score_seq(0),
+      scheduler_session(0), schedule_chunks(false), reactor(Reactor::Shared()), tick_timer(0), file_watch(0),
+      plan_cache(PlanCache::Global()),
+      candidate_margin(EvaluationController::kDefaultCandidateMargin),
+      alignment_mode(AlignmentMode::WINDOW),
+      evaluation_cancelled(false), resident_blocks(0) {
+    
+    if (!this->recognition_engine) {
+        throw std::invalid_argument("EngineCoordinator: recognition_engine이 비어 있습니다.");
+    }
+    state_snapshot = std::make_shared<const EngineState>(BuildState());
+    LOG_INFO("EngineCoordinator", "공유 RecognitionEngine으로 EngineCoordinator 초기화 완료");
+}
+
 EngineCoordinator::~EngineCoordinator() {
     StopEvaluation();
+    DetachScheduler();
 }
 
 void EngineCoordinator::SetRecordListener(const RecordListener& record_listener) {
     this->record_listener = record_listener;
 }
 
+void EngineCoordinator::SetScoreEventMode(ScoreEventMode mode) {
+    score_event_mode = mode;
+    snapshot_requested = true;
+}
+
+void EngineCoordinator::RequestSnapshot() {
+    snapshot_requested = true;
+}
+
+void EngineCoordinator::SetResultEncoding(ResultEncoding encoding) {
+    result_encoding = encoding;
+}
+
+void EngineCoordinator::SetInferenceScheduler(std::shared_ptr<InferenceScheduler> scheduler, float latency_slo) {
+    if (is_running) {
+        LOG_WARNING("EngineCoordinator", "평가 중에는 스케줄러를 바꿀 수 없습니다.");
+        return;
+    }
+    
+    DetachScheduler();
+    this->scheduler = std::move(scheduler);
+    if (this->scheduler) {
+        scheduler_session = this->scheduler->RegisterSession(latency_slo,
+            [this](const AudioProcessor::AudioTensor& chunk, const std::map<std::string, std::any>& metadata) {
+                this->ProcessChunk(chunk, metadata);
+            });
+    }
+}
+
+StageMetrics::Snapshot EngineCoordinator::GetMetrics() const {
+    return stage_metrics.GetSnapshot();
+}
+
+InferenceScheduler::SessionStats EngineCoordinator::GetSchedulingStats() const {
+    if (!scheduler) {
+        return InferenceScheduler::SessionStats();
+    }
+    return scheduler->GetSessionStats(scheduler_session);
+}
+
+bool EngineCoordinator::WaitForPendingChunks(size_t max_pending, double timeout_seconds) {
+    if (!schedule_chunks || !scheduler) {
+        return true;
+    }
+    return scheduler->WaitForBacklog(scheduler_session, max_pending,
+        std::chrono::duration_cast<InferenceScheduler::Clock::duration>(std::chrono::duration<double>(timeout_seconds)));
+}
+
+void EngineCoordinator::SetReactor(std::shared_ptr<Reactor> reactor) {
+    if (is_running) {
+        LOG_WARNING("EngineCoordinator", "평가 중에는 Reactor를 바꿀 수 없습니다.");
+        return;
+    }
+    this->reactor = std::move(reactor);
+}
+
+void EngineCoordinator::SetPlanCache(std::shared_ptr<PlanCache> plan_cache) {
+    this->plan_cache = std::move(plan_cache);
+}
+
+void EngineCoordinator::SetCandidateMargin(float margin) {
+    candidate_margin = margin;
+}
+
+void EngineCoordinator::SetAlignmentMode(AlignmentMode mode) {
+    alignment_mode = mode;
+}
+
+void EngineCoordinator::SetFrameStoreOptions(const FrameStore::Options& options) {
+    frame_store_options = options;
+}
+
+std::optional<GopResult> EngineCoordinator::RescoreBlock(int block_id, double begin_seconds, double end_seconds) const {
+    if (!eval_controller) {
+        return std::nullopt;
+    }
+    return eval_controller->RescoreBlock(block_id, begin_seconds, end_seconds);
+}
+
+void EngineCoordinator::SetLongFormMode(size_t resident_blocks, const std::string& spill_path) {
+    this->resident_blocks = resident_blocks;
+    this->spill_path = spill_path;
+}
+
+void EngineCoordinator::FinishAlignment() {
+    // 오디오 끝에서 남은 블록(마지막 블록 포함)을 확정하고 점수 이벤트를 보낸다
+    StageMetrics::Scope metrics_scope(&stage_metrics);
+    try {
+        bool finished;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            finished = eval_controller && eval_controller->FinishAlignment();
+        }
+        if (finished) {
+            PublishState();
+            EmitScoreEvent(eval_controller->GetResult());
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("EngineCoordinator", "정렬 마무리 오류: " + std::string(e.what()));
+    }
+}
+
+void EngineCoordinator::DetachScheduler() {
+    if (scheduler) {
+        scheduler->UnregisterSession(scheduler_session);
+        scheduler.reset();
+        scheduler_session = 0;
+    }
+}
+
 bool EngineCoordinator::Initialize(const std::string& sentence, float audio_polling_interval, float min_time_between_evals) {
+    // 세션 객체를 교체하는 동안 지연 상태 생성이 옛 객체와 새 객체를 섞어 읽지 않게 한다
+    std::lock_guard<std::mutex> lock(state_mutex);
     try {
+        // 컴파일된 문장 계획 (블록 분할, 블록별 토큰/컨텍스트). 캐시에 있으면 토크나이저를 거치지 않는다
+        std::shared_ptr<const SentencePlan> plan = plan_cache
+            ? plan_cache->GetOrCompile(*recognition_engine, sentence)
+            : SentencePlan::Compile(*recognition_engine, SentenceBlockManager::SplitBlocks(sentence));
+        
         // 문장 블록 관리자 초기화
-        sentence_manager = std::make_shared<SentenceBlockManager>(sentence);
+        sentence_manager = std::make_shared<SentenceBlockManager>(plan->block_texts);
         
         // 진행 추적기 초기화
         progress_tracker = std::make_shared<ProgressTracker>(
             sentence_manager->blocks.size(), 3, true);
+        progress_tracker->SetBlockSyllables(plan->block_syllables);
         
         // 오디오 프로세서 초기화
         audio_processor = std::make_shared<AudioProcessor>(
-            16000, 2.0f, audio_polling_interval);
+            Wav2VecCTCOnnxCore::kSampleRate, 2.0f, audio_polling_interval);
+        audio_processor->SetStageMetrics(&stage_metrics);
+        
+        // 고정 길이 대신 2초 ± 0.5초 범위의 무음 지점에서 청크 분할
+        audio_processor->SetAdaptiveChunking(true, 0.5f, 1.0f, 3.0f);
         
         // 평가 컨트롤러 초기화
         eval_controller = std::make_shared<EvaluationController>(
             recognition_engine,
             sentence_manager,
             progress_tracker,
+            plan,
             confidence_threshold,
-            min_time_between_evals);
+            min_time_between_evals,
+            candidate_margin);
+        if (alignment_mode == AlignmentMode::INCREMENTAL) {
+            eval_controller->EnableIncrementalAlignment();
+        }
+        eval_controller->EnableFrameStore(frame_store_options);
+        if (resident_blocks > 0) {
+            spill_stream.reset();
+            if (!spill_path.empty()) {
+                spill_stream = std::make_unique<std::ofstream>(spill_path, std::ios::trunc);
+                if (!*spill_stream) {
+                    LOG_ERROR("EngineCoordinator", "장문 블록 결과 파일을 열 수 없음: " + spill_path);
+                    spill_stream.reset();
+                }
+            }
+            // 내려진 블록은 청크 처리 스레드에서 한 줄씩 JSON으로 기록된다
+            eval_controller->EnableResidency(resident_blocks, [this](const BlockResult& block) {
+                if (spill_stream) {
+                    *spill_stream << spill_writer.Write(block) << '\n';
+                }
+            });
+        }
         
         // 오디오 처리 이벤트 등록
         audio_processor->AddChunkCallback(
@@ -79,7 +295,16 @@ bool EngineCoordinator::Initialize(const std::string& sentence, float audio_poll
                 this->OnNewChunk(chunk, metadata);
             });
         
+        // 새 문장이므로 델타 시퀀스를 다시 시작하고 첫 이벤트는 스냅샷으로 보낸다
+        score_seq = 0;
+        sent_block_revisions.assign(sentence_manager->blocks.size(), 0);
+        snapshot_requested = true;
+        schedule_chunks = false;
+        // 이전 평가의 취소는 새 문장에 이어지지 않는다 (EvaluateFile/StartStream도 여기를 거친다)
+        evaluation_cancelled = false;
+        
         is_initialized = true;
+        PublishState();
         
         std::stringstream ss;
         ss << "시스템 초기화 완료: '" << sentence << "' (" 
@@ -120,8 +345,13 @@ bool EngineCoordinator::StartEvaluation(const std::string& audio_file_path) {
             return false;
         }
         
-        // 오디오 모니터링 시작
-        if (!audio_processor->StartMonitoring()) {
+        // 오디오 모니터링 시작 (Reactor가 있으면 파일 변경 이벤트와 주기 확인을 공유 루프에 등록)
+        if (reactor) {
+            auto processor = audio_processor;
+            file_watch = reactor->AddFileWatch(audio_file_path, audio_processor->GetPollingInterval(),
+                [processor]() { processor->PollFile(); });
+        }
+        if (reactor ? file_watch == 0 : !audio_processor->StartMonitoring()) {
             std::string error_msg = "오디오 모니터링 시작 실패";
             LOG_ERROR("EngineCoordinator", error_msg);
             if (record_listener.on_start_record_fail) {
@@ -133,9 +363,15 @@ bool EngineCoordinator::StartEvaluation(const std::string& audio_file_path) {
         // 진행 추적 시작
         progress_tracker->Start();
         
-        // 타이머 스레드 시작 (주기적 틱 이벤트용)
+        // 타이머 시작 (주기적 틱 이벤트용)
+        schedule_chunks = scheduler != nullptr;
+        evaluation_cancelled = false;
         is_running = true;
-        timer_thread = std::make_unique<std::thread>(&EngineCoordinator::TimerLoop, this);
+        if (reactor) {
+            tick_timer = reactor->AddTimer(update_interval, [this]() { Tick(); });
+        } else {
+            timer_thread = std::make_unique<std::thread>(&EngineCoordinator::TimerLoop, this);
+        }
         
         // 시작 이벤트 호출
         if (record_listener.on_start) {
@@ -166,10 +402,37 @@ void EngineCoordinator::StopEvaluation() {
         timer_thread.reset();
     }
     
+    // Remove는 실행 중인 콜백이 끝날 때까지 기다린다
+    if (reactor) {
+        reactor->Remove(tick_timer);
+        reactor->Remove(file_watch);
+        tick_timer = 0;
+        file_watch = 0;
+    }
+    
     if (audio_processor) {
         audio_processor->StopMonitoring();
     }
     
+    // 중지 전에 도착한 청크는 직접 처리할 때와 같이 모두 평가되도록 대기
+    if (schedule_chunks) {
+        scheduler->Drain(scheduler_session);
+        schedule_chunks = false;
+    }
+    FinishAlignment();
+    
+    // 문장을 끝내기 전에 멈췄으면 그때까지의 결과로 비동기 평가 완료
+    if (std::atomic_load(&pending_evaluation)) {
+        EngineState state = GetState();
+        if (eval_controller) {
+            state.result = eval_controller->GetResult();
+            if (state.result->eof) {
+                state.status = "completed";
+            }
+        }
+        CompleteEvaluation(std::move(state));
+    }
+    
     // 종료 이벤트 호출
     if (record_listener.on_record_end) {
         record_listener.on_record_end();
@@ -180,23 +443,30 @@ void EngineCoordinator::StopEvaluation() {
 
 void EngineCoordinator::TimerLoop() {
     while (is_running) {
-        try {
-            // 진행 상태 확인
-            if (sentence_manager && record_listener.on_tick) {
-                int current = sentence_manager->active_block_id + 1;
-                int total = sentence_manager->blocks.size();
-                record_listener.on_tick(current, total);
-            }
-            
-            // 다음 틱까지 대기
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(static_cast<int>(update_interval * 1000)));
-        } catch (const std::exception& e) {
-            std::string error_msg = "타이머 루프 오류: " + std::string(e.what());
-            LOG_ERROR("EngineCoordinator", error_msg);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(static_cast<int>(update_interval * 1000)));
+        Tick();
+        
+        // 다음 틱까지 대기
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(static_cast<int>(update_interval * 1000)));
+    }
+}
+
+void EngineCoordinator::Tick() {
+    try {
+        // 진행 상태 확인 (청크 처리 스레드가 게시한 진행 값만 읽는다, 스냅샷은 만들지 않는다)
+        int total_blocks = tick_total_blocks.load(std::memory_order_relaxed);
+        if (total_blocks >= 0 && record_listener.on_tick) {
+            record_listener.on_tick(tick_block.load(std::memory_order_relaxed), total_blocks);
+        }
+        
+        // 취소 요청은 틱에서 확정한다 (CancellationToken은 코디네이터를 모르므로)
+        auto pending = std::atomic_load(&pending_evaluation);
+        if (pending && pending->cancel->IsCancelled()) {
+            CompleteEvaluation(GetState());
         }
+    } catch (const std::exception& e) {
+        std::string error_msg = "타이머 루프 오류: " + std::string(e.what());
+        LOG_ERROR("EngineCoordinator", error_msg);
     }
 }
 
@@ -204,60 +474,50 @@ void EngineCoordinator::OnNewChunk(
     const AudioProcessor::AudioTensor& audio_chunk, 
     const std::map<std::string, std::any>& metadata) {
     
+    if (!is_running || audio_chunk.size() == 0) {
+        return;
+    }
+    
+    // 취소된 비동기 평가는 더 이상 채점하지 않는다
+    auto pending = std::atomic_load(&pending_evaluation);
+    if (evaluation_cancelled || (pending && pending->cancel->IsCancelled())) {
+        return;
+    }
+    
+    // 스케줄러가 있으면 도착 시각 기준 마감으로 넘기고, 없으면 이 스레드에서 바로 처리
+    if (schedule_chunks) {
+        scheduler->Submit(scheduler_session, audio_chunk, metadata);
+        return;
+    }
+    
+    ProcessChunk(audio_chunk, metadata);
+}
+
+void EngineCoordinator::ProcessChunk(
+    const AudioProcessor::AudioTensor& audio_chunk, 
+    const std::map<std::string, std::any>& metadata) {
+    
+    // 스케줄러 작업자에서 실행될 수 있으므로 여기서 세션 지표를 지정한다
+    StageMetrics::Scope metrics_scope(&stage_metrics);
+    ScopedStageTimer timer(Stage::CHUNK);
     try {
-        if (!is_running) {
-            return;
+        // 인식 결과 처리
+        EvaluationResult result;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            result = eval_controller->ProcessRecognitionResult(audio_chunk, metadata);
         }
+        PublishState();
         
-        // 인식 결과 처리
-        if (audio_chunk.size() > 0) {
-            auto result = eval_controller->ProcessRecognitionResult(audio_chunk, metadata);
-            
-            // 결과 스코어 이벤트 호출
-            if (record_listener.on_score) {
-                // JSON 문자열로 변환 (SpeechSuper와 유사하게)
-                nlohmann::json json_result;
-                
-                // ResultMap을 JSON으로 변환
-                std::function<void(const std::map<std::string, std::any>&, nlohmann::json&)> convert_map;
-                convert_map = [&convert_map](const std::map<std::string, std::any>& map, nlohmann::json& json) {
-                    for (const auto& [key, value] : map) {
-                        try {
-                            if (value.type() == typeid(int)) {
-                                json[key] = std::any_cast<int>(value);
-                            } else if (value.type() == typeid(float)) {
-                                json[key] = std::any_cast<float>(value);
-                            } else if (value.type() == typeid(double)) {
-                                json[key] = std::any_cast<double>(value);
-                            } else if (value.type() == typeid(bool)) {
-                                json[key] = std::any_cast<bool>(value);
-                            } else if (value.type() == typeid(std::string)) {
-                                json[key] = std::any_cast<std::string>(value);
-                            } else if (value.type() == typeid(std::vector<std::map<std::string, std::any>>)) {
-                                auto vec = std::any_cast<std::vector<std::map<std::string, std::any>>>(value);
-                                nlohmann::json json_array = nlohmann::json::array();
-                                for (const auto& item : vec) {
-                                    nlohmann::json json_item;
-                                    convert_map(item, json_item);
-                                    json_array.push_back(json_item);
-                                }
-                                json[key] = json_array;
-                            } else if (value.type() == typeid(std::map<std::string, std::any>)) {
-                                auto nested_map = std::any_cast<std::map<std::string, std::any>>(value);
-                                nlohmann::json nested_json;
-                                convert_map(nested_map, nested_json);
-                                json[key] = nested_json;
-                            }
-                        } catch (const std::exception& e) {
-                            LOG_ERROR("EngineCoordinator", "JSON 변환 오류: " + std::string(e.what()));
-                        }
-                    }
-                };
-                
-                convert_map(result, json_result);
-                std::string result_json = json_result.dump();
-                record_listener.on_score(result_json);
-            }
+        // 결과 스코어 이벤트 호출
+        EmitScoreEvent(result);
+        
+        // 문장을 다 읽었으면 비동기 평가 완료
+        if (result.eof) {
+            EngineState state = GetState();
+            state.status = "completed";
+            state.result = result;
+            CompleteEvaluation(std::move(state));
         }
     } catch (const std::exception& e) {
         std::string error_msg = "청크 처리 오류: " + std::string(e.what());
@@ -265,52 +525,173 @@ void EngineCoordinator::OnNewChunk(
     }
 }
 
-std::map<std::string, std::any> EngineCoordinator::GetCurrentState() const {
+void EngineCoordinator::EmitScoreEvent(const EvaluationResult& result) {
+    if (!record_listener.on_score) {
+        return;
+    }
+    
+    // JSON 문자열(SpeechSuper와 유사) 또는 MessagePack으로 변환 - DOM 없이 세션 버퍼에 직접 기록.
+    // 직렬화 시간만 재고 콜백 시간은 빼기 위해 버퍼 참조를 받아 둔다
+    bool binary = result_encoding == ResultEncoding::MSGPACK;
+    const std::string* payload = nullptr;
+    if (score_event_mode == ScoreEventMode::FULL) {
+        ScopedStageTimer timer(Stage::SERIALIZE);
+        payload = binary ? &score_msgpack_writer.Write(result) : &score_writer.Write(result);
+    } else {
+        ScopedStageTimer timer(Stage::SERIALIZE);
+        
+        // 델타: revision이 바뀐 블록만 (스냅샷이면 전체 블록, 장문 모드에서는 상주 블록 전체)
+        bool snapshot = snapshot_requested.exchange(false);
+        score_delta.seq = score_seq++;
+        score_delta.snapshot = snapshot;
+        score_delta.overall = result.overall;
+        score_delta.pronunciation = result.pronunciation;
+        score_delta.eof = result.eof;
+        score_delta.completed = sentence_manager->GetAggregates().completed;
+        score_delta.total = sentence_manager->blocks.size();
+        score_delta.blocks.clear();
+        
+        // 상주 범위 밖의 블록은 내려졌거나 한 번도 바뀌지 않았다
+        const bool long_form = sentence_manager->GetResidency() > 0;
+        const size_t begin = sentence_manager->ResidentBegin();
+        const size_t end = snapshot && !long_form ? sentence_manager->blocks.size() : sentence_manager->ResidentEnd();
+        sent_block_revisions.resize(sentence_manager->blocks.size(), 0);
+        for (size_t i = begin; i < end; ++i) {
+            const auto& block = sentence_manager->blocks[i];
+            if (snapshot || block->revision != sent_block_revisions[i]) {
+                score_delta.blocks.push_back(block->ToResult());
+                sent_block_revisions[i] = block->revision;
+            }
+        }
+        
+        payload = binary ? &score_msgpack_writer.Write(score_delta) : &score_writer.Write(score_delta);
+    }
+    
+    record_listener.on_score(*payload);
+}
+
+EngineState EngineCoordinator::GetState() const {
+    // 게시된 스냅샷의 복사본에 실행 상태만 현재 값으로 덮어쓴다
+    EngineState state = *GetStateSnapshot();
+    if (state.initialized) {
+        state.status = is_running ? "running" : "stopped";
+    }
+    return state;
+}
+
+std::shared_ptr<const EngineState> EngineCoordinator::GetStateSnapshot() const {
+    // 바뀐 뒤 처음 읽을 때 한 번만 만든다. 청크 처리 중이면 기다리지 않고 직전 스냅샷을 준다
+    if (state_dirty.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(state_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            snapshot_missed.store(true, std::memory_order_relaxed);  // 처리가 끝나면 변경 스레드가 만든다
+        } else if (state_dirty.exchange(false, std::memory_order_acq_rel)) {
+            std::atomic_store(&state_snapshot,
+                              std::shared_ptr<const EngineState>(std::make_shared<EngineState>(BuildState())));
+        }
+    }
+    return std::atomic_load(&state_snapshot);
+}
+
+void EngineCoordinator::PublishState() {
+    // 틱 진행 표시는 스냅샷 없이 읽는다
+    tick_block.store(is_initialized ? sentence_manager->active_block_id + 1 : 0, std::memory_order_relaxed);
+    tick_total_blocks.store(is_initialized ? static_cast<int>(sentence_manager->blocks.size()) : -1,
+                            std::memory_order_relaxed);
+    
+    // 처리 중에 읽어 직전 스냅샷을 받은 쪽이 있으면 바로 만들어 둔다 (변경 스레드라 잠그지 않고 읽어도 된다)
+    if (snapshot_missed.exchange(false, std::memory_order_relaxed)) {
+        std::atomic_store(&state_snapshot,
+                          std::shared_ptr<const EngineState>(std::make_shared<EngineState>(BuildState())));
+        state_dirty.store(false, std::memory_order_release);
+    } else {
+        state_dirty.store(true, std::memory_order_release);
+    }
+}
+
+EngineState EngineCoordinator::BuildState() const {
+    EngineState state;
     if (!is_initialized) {
-        std::map<std::string, std::any> result;
-        result["status"] = std::string("not_initialized");
-        return result;
+        state.status = "not_initialized";
+        return state;
     }
     
-    std::map<std::string, std::any> result;
-    result["status"] = std::string(is_running ? "running" : "stopped");
+    state.initialized = true;
+    state.status = is_running ? "running" : "stopped";
+    state.current_block = sentence_manager->active_block_id + 1;
+    state.total_blocks = sentence_manager->blocks.size();
     
-    std::map<std::string, std::any> progress;
-    progress["current"] = sentence_manager->active_block_id + 1;
-    progress["total"] = sentence_manager->blocks.size();
-    result["progress"] = progress;
+    // 오디오 청크 통계 (VAD로 건너뛴 무음 청크 포함)
+    if (audio_processor) {
+        state.audio = AudioStats{audio_processor->GetTotalChunks(), audio_processor->GetSilentChunks()};
+    }
     
     // 평가 요약 정보 추가
     if (eval_controller) {
-        auto evaluation_summary = eval_controller->GetEvaluationSummary();
-        for (const auto& [key, value] : evaluation_summary) {
-            result[key] = value;
-        }
+        state.summary = eval_controller->GetEvaluationSummary();
     }
     
-    return result;
+    return state;
+}
+
+std::map<std::string, std::any> EngineCoordinator::GetCurrentState() const {
+    return ToMap(GetState());
 }
 
 void EngineCoordinator::Reset() {
     StopEvaluation();
     
-    if (sentence_manager) {
-        sentence_manager->Reset();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        if (sentence_manager) {
+            sentence_manager->Reset();
+        }
+        
+        if (progress_tracker) {
+            progress_tracker->Reset();
+        }
+        
+        if (eval_controller) {
+            eval_controller->Reset();
+        }
+        
+        if (audio_processor) {
+            audio_processor->Reset();
+        }
     }
+    PublishState();
     
-    if (progress_tracker) {
-        progress_tracker->Reset();
-    }
+    LOG_INFO("EngineCoordinator", "시스템 초기화됨");
+}
+
+EngineState EngineCoordinator::EvaluateSpeechState(
+    const std::string& sentence,
+    const std::string& audio_file_path,
+    const RecordListener& record_listener) {
     
-    if (eval_controller) {
-        eval_controller->Reset();
+    SetRecordListener(record_listener);
+    
+    if (!Initialize(sentence)) {
+        if (this->record_listener.on_start_record_fail) {
+            this->record_listener.on_start_record_fail("초기화 실패");
+        }
+        
+        EngineState state;
+        state.status = "initialization_failed";
+        return state;
     }
     
-    if (audio_processor) {
-        audio_processor->Reset();
+    if (!StartEvaluation(audio_file_path)) {
+        if (this->record_listener.on_start_record_fail) {
+            this->record_listener.on_start_record_fail("평가 시작 실패");
+        }
+        
+        EngineState state;
+        state.status = "start_failed";
+        return state;
     }
     
-    LOG_INFO("EngineCoordinator", "시스템 초기화됨");
+    return GetState();
 }
 
 std::map<std::string, std::any> EngineCoordinator::EvaluateSpeech(
@@ -318,9 +699,87 @@ std::map<std::string, std::any> EngineCoordinator::EvaluateSpeech(
     const std::string& audio_file_path,
     const RecordListener& record_listener) {
     
+    return ToMap(EvaluateSpeechState(sentence, audio_file_path, record_listener));
+}
+
+std::future<EngineState> EngineCoordinator::EvaluateSpeechAsync(
+    const std::string& sentence,
+    const std::string& audio_file_path,
+    const RecordListener& record_listener,
+    CompletionCallback on_complete,
+    std::shared_ptr<CancellationToken> cancel) {
+    
+    auto pending = std::make_shared<PendingEvaluation>();
+    pending->on_complete = std::move(on_complete);
+    pending->cancel = cancel ? std::move(cancel) : std::make_shared<CancellationToken>();
+    std::future<EngineState> future = pending->promise.get_future();
+    
+    // 첫 청크가 시작 직후 문장을 끝낼 수 있으므로 시작 전에 등록한다. 비어 있을 때만 CAS로 등록하므로
+    // 동시에 호출한 쪽 중 하나만 시작하고, 진행 중인 평가의 완료 대기는 건드리지 않는다
+    std::shared_ptr<PendingEvaluation> expected;
+    if (is_running || !std::atomic_compare_exchange_strong(&pending_evaluation, &expected, pending)) {
+        LOG_WARNING("EngineCoordinator", "이미 평가가 진행 중입니다.");
+        EngineState state;
+        state.status = "busy";
+        ResolvePending(*pending, std::move(state));
+        return future;
+    }
+    
+    EngineState state = EvaluateSpeechState(sentence, audio_file_path, record_listener);
+    if (!is_running) {
+        CompleteEvaluation(std::move(state));
+    }
+    return future;
+}
+
+void EngineCoordinator::CancelEvaluation() {
+    auto pending = std::atomic_load(&pending_evaluation);
+    if (pending) {
+        pending->cancel->Cancel();
+    }
+}
+
+void EngineCoordinator::CompleteEvaluation(EngineState state) {
+    auto pending = std::atomic_exchange(&pending_evaluation, std::shared_ptr<PendingEvaluation>());
+    if (!pending) {
+        return;
+    }
+    
+    if (pending->cancel->IsCancelled()) {
+        evaluation_cancelled = true;
+        state.status = "cancelled";
+    }
+    ResolvePending(*pending, std::move(state));
+}
+
+void EngineCoordinator::ResolvePending(PendingEvaluation& pending, EngineState state) {
+    if (pending.on_complete) {
+        try {
+            pending.on_complete(state);
+        } catch (const std::exception& e) {
+            LOG_ERROR("EngineCoordinator", "완료 콜백 오류: " + std::string(e.what()));
+        }
+    }
+    pending.promise.set_value(std::move(state));
+}
+
+std::map<std::string, std::any> EngineCoordinator::EvaluateFile(
+    const std::string& sentence,
+    const std::string& audio_file_path,
+    bool chunked,
+    const RecordListener& record_listener) {
+    
+    if (is_running) {
+        LOG_WARNING("EngineCoordinator", "이미 평가가 진행 중입니다.");
+        std::map<std::string, std::any> result;
+        result["status"] = std::string("busy");
+        return result;
+    }
+    
     SetRecordListener(record_listener);
     
-    if (!Initialize(sentence)) {
+    // 오프라인에서는 평가 간 최소 간격(벽시계 기준)을 두지 않아 결과가 결정적이다
+    if (!Initialize(sentence, 0.0f, 0.0f)) {
         if (this->record_listener.on_start_record_fail) {
             this->record_listener.on_start_record_fail("초기화 실패");
         }
@@ -330,9 +789,22 @@ std::map<std::string, std::any> EngineCoordinator::EvaluateSpeech(
         return result;
     }
     
-    if (!StartEvaluation(audio_file_path)) {
+    progress_tracker->Start();
+    is_running = true;
+    if (this->record_listener.on_start) {
+        this->record_listener.on_start();
+    }
+    
+    // 모든 청크 콜백이 이 스레드에서 순서대로 실행된다
+    StageMetrics::Scope metrics_scope(&stage_metrics);
+    bool processed = audio_processor->ProcessFile(audio_file_path, chunked);
+    is_running = false;
+    
+    if (!processed) {
+        std::string error_msg = "오디오 파일 처리 실패: " + audio_file_path;
+        LOG_ERROR("EngineCoordinator", error_msg);
         if (this->record_listener.on_start_record_fail) {
-            this->record_listener.on_start_record_fail("평가 시작 실패");
+            this->record_listener.on_start_record_fail(error_msg);
         }
         
         std::map<std::string, std::any> result;
@@ -340,11 +812,215 @@ std::map<std::string, std::any> EngineCoordinator::EvaluateSpeech(
         return result;
     }
     
-    return GetCurrentState();
+    FinishAlignment();
+    
+    if (this->record_listener.on_record_end) {
+        this->record_listener.on_record_end();
+    }
+    
+    EngineState state = GetState();
+    state.status = "completed";
+    state.result = eval_controller->GetResult();
+    return ToMap(state);
+}
+
+std::map<std::string, std::any> EngineCoordinator::EvaluateLongForm(
+    const std::string& sentence,
+    const std::string& audio_file_path,
+    size_t num_threads,
+    const RecordListener& record_listener) {
+    
+    if (is_running) {
+        LOG_WARNING("EngineCoordinator", "이미 평가가 진행 중입니다.");
+        std::map<std::string, std::any> result;
+        result["status"] = std::string("busy");
+        return result;
+    }
+    
+    SetRecordListener(record_listener);
+    
+    if (!Initialize(sentence, 0.0f, 0.0f)) {
+        if (this->record_listener.on_start_record_fail) {
+            this->record_listener.on_start_record_fail("초기화 실패");
+        }
+        
+        std::map<std::string, std::any> result;
+        result["status"] = std::string("initialization_failed");
+        return result;
+    }
+    
+    // 파일 읽기와 세그먼트 병합은 이 스레드, 인코더 추론은 풀 작업자에서 세션 지표에 기록
+    StageMetrics::Scope metrics_scope(&stage_metrics);
+    AudioProcessor::AudioTensor audio;
+    if (!audio_processor->LoadFile(audio_file_path, audio)) {
+        std::string error_msg = "오디오 파일 처리 실패: " + audio_file_path;
+        LOG_ERROR("EngineCoordinator", error_msg);
+        if (this->record_listener.on_start_record_fail) {
+            this->record_listener.on_start_record_fail(error_msg);
+        }
+        
+        std::map<std::string, std::any> result;
+        result["status"] = std::string("start_failed");
+        return result;
+    }
+    
+    progress_tracker->Start();
+    is_running = true;
+    if (this->record_listener.on_start) {
+        this->record_listener.on_start();
+    }
+    
+    auto start_time = std::chrono::steady_clock::now();
+    std::vector<AudioProcessor::AudioTensor> segments = audio_processor->SplitAtPauses(audio);
+    
+    std::vector<float> durations;
+    durations.reserve(segments.size());
+    const float sample_rate = static_cast<float>(audio_processor->GetSampleRate());
+    for (const auto& segment : segments) {
+        durations.push_back(static_cast<float>(segment.size()) / sample_rate);
+    }
+    float remaining_duration = std::accumulate(durations.begin(), durations.end(), 0.0f);
+    
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    {
+        // 인코더 추론은 병렬로, 블록 병합은 세그먼트 순서대로 (앞 세그먼트의 frontier가 필요)
+        ThreadPool pool(std::min(num_threads, std::max<size_t>(1, segments.size())));
+        auto engine = recognition_engine;
+        StageMetrics* metrics = &stage_metrics;
+        
+        std::vector<std::future<Wav2VecCTCOnnxCore::EncoderOutput>> outputs;
+        outputs.reserve(segments.size());
+        for (const auto& segment : segments) {
+            outputs.push_back(pool.Submit([engine, metrics, &segment]() {
+                StageMetrics::Scope metrics_scope(metrics);
+                return engine->RunEncoder(segment);
+            }));
+        }
+        
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            try {
+                auto output = outputs[i].get();
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex);
+                    eval_controller->MergeSegmentAlignment(output, durations[i], remaining_duration);
+                }
+                PublishState();
+            } catch (const std::exception& e) {
+                std::stringstream ss;
+                ss << "세그먼트 " << i << " 처리 오류: " << e.what();
+                LOG_ERROR("EngineCoordinator", ss.str());
+            }
+            remaining_duration -= durations[i];
+            
+            EmitScoreEvent(eval_controller->GetResult());
+        }
+    }
+    is_running = false;
+    
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::stringstream ss;
+    ss << "장문 평가 완료: " << segments.size() << " 세그먼트, " << elapsed << "초 (스레드 " << num_threads << ")";
+    LOG_INFO("EngineCoordinator", ss.str());
+    
+    if (this->record_listener.on_record_end) {
+        this->record_listener.on_record_end();
+    }
+    
+    EngineState state = GetState();
+    state.status = "completed";
+    state.result = eval_controller->GetResult();
+    return ToMap(state);
 }
 
 std::map<std::string, std::any> EngineCoordinator::GetResults() const {
     return GetCurrentState();
 }
 
+bool EngineCoordinator::StartStream(const std::string& sentence, int input_sample_rate, int channels) {
+    if (is_running) {
+        LOG_WARNING("EngineCoordinator", "이미 평가가 진행 중입니다.");
+        return false;
+    }
+    
+    if (input_sample_rate <= 0 || channels <= 0) {
+        LOG_ERROR("EngineCoordinator", "잘못된 스트림 형식입니다.");
+        return false;
+    }
+    
+    // 오디오가 실시간보다 빠르게 들어올 수 있으므로 평가 간 벽시계 간격을 두지 않는다
+    if (!Initialize(sentence, 0.0f, 0.0f)) {
+        if (record_listener.on_start_record_fail) {
+            record_listener.on_start_record_fail("초기화 실패");
+        }
+        return false;
+    }
+    
+    audio_processor->StartStream(input_sample_rate, channels);
+    progress_tracker->Start();
+    schedule_chunks = scheduler != nullptr;
+    is_running = true;
+    // 스트림은 세션 스레드를 만들지 않으므로 틱은 Reactor가 있고 받을 리스너가 있을 때만 등록한다
+    if (reactor && record_listener.on_tick && update_interval > 0.0f) {
+        tick_timer = reactor->AddTimer(update_interval, [this]() { Tick(); });
+    }
+    if (record_listener.on_start) {
+        record_listener.on_start();
+    }
+    
+    return true;
+}
+
+void EngineCoordinator::PushAudio(const float* interleaved, size_t frames) {
+    if (!is_running) {
+        return;
+    }
+    StageMetrics::Scope metrics_scope(&stage_metrics);
+    audio_processor->PushAudio(interleaved, frames);
+}
+
+EngineState EngineCoordinator::FinishStream() {
+    if (!is_initialized) {
+        return GetState();
+    }
+    
+    // 남은 버퍼를 청크로 내보낸 뒤 종료
+    if (is_running) {
+        if (reactor) {
+            reactor->Remove(tick_timer);
+            tick_timer = 0;
+        }
+        audio_processor->Flush();
+        if (schedule_chunks) {
+            scheduler->Drain(scheduler_session);
+            schedule_chunks = false;
+        }
+        is_running = false;
+        FinishAlignment();
+        
+        if (record_listener.on_record_end) {
+            record_listener.on_record_end();
+        }
+    }
+    
+    EngineState state = GetState();
+    state.status = "completed";
+    state.result = eval_controller->GetResult();
+    return state;
+}
+
+const std::string& EngineCoordinator::GetResultsBinary() {
+    return api_msgpack_writer.Write(GetState());
+}
+
+const std::string& EngineCoordinator::EvaluateSpeechBinary(
+    const std::string& sentence,
+    const std::string& audio_file_path,
+    const RecordListener& record_listener) {
+    
+    return api_msgpack_writer.Write(EvaluateSpeechState(sentence, audio_file_path, record_listener));
+}
+
 } // namespace realtime_engine_ko
\ No newline at end of file
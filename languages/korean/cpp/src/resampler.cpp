@@ -0,0 +1,121 @@
+// src/cpp/src/resampler.cpp
+#include "realtime_engine_ko/resampler.h"
+#include "realtime_engine_ko/common.h"
+#include <sstream>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+
+namespace realtime_engine_ko {
+
+PolyphaseResampler::PolyphaseResampler(int input_rate, int output_rate, int channels, int taps_per_phase)
+    : input_rate(input_rate), output_rate(output_rate), channels(channels),
+      taps_per_phase(taps_per_phase), up(1), down(1), next_base(0), next_phase(0) {
+
+    if (input_rate <= 0 || output_rate <= 0 || channels <= 0 || taps_per_phase <= 0) {
+        throw std::invalid_argument("잘못된 리샘플러 파라미터");
+    }
+
+    // 44100 → 16000 : L=160, M=441 / 48000 → 16000 : L=1, M=3 / 8000 → 16000 : L=2, M=1
+    int g = std::gcd(input_rate, output_rate);
+    up = output_rate / g;
+    down = input_rate / g;
+
+    if (!IsPassthrough()) {
+        DesignFilter();
+    }
+    Reset();
+
+    std::stringstream ss;
+    ss << "PolyphaseResampler 초기화: " << input_rate << "Hz → " << output_rate
+       << "Hz (L=" << up << ", M=" << down << ", 채널=" << channels << ")";
+    LOG_INFO("PolyphaseResampler", ss.str());
+}
+
+void PolyphaseResampler::DesignFilter() {
+    // Blackman 창을 씌운 windowed-sinc 저역통과 필터 (보간 후 샘플링 레이트 기준)
+    const int num_taps = taps_per_phase * up;
+    const double upsampled_rate = static_cast<double>(input_rate) * up;
+    const double cutoff = 0.5 * std::min(input_rate, output_rate) * 0.92 / upsampled_rate;
+    const double center = 0.5 * (num_taps - 1);
+
+    std::vector<double> prototype(num_taps);
+    for (int i = 0; i < num_taps; ++i) {
+        double x = i - center;
+        double sinc = (x == 0.0) ? 2.0 * cutoff : std::sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+        double window = 0.42 - 0.5 * std::cos(2.0 * M_PI * i / (num_taps - 1))
+                      + 0.08 * std::cos(4.0 * M_PI * i / (num_taps - 1));
+        // 보간으로 인한 에너지 손실 보정을 위해 L배
+        prototype[i] = sinc * window * up;
+    }
+
+    // 위상 p의 탭 k는 prototype[k * L + p] - 히스토리 [base - K + 1, base]와 내적하도록 역순 배치
+    phase_filters.resize(taps_per_phase, up);
+    for (int p = 0; p < up; ++p) {
+        for (int k = 0; k < taps_per_phase; ++k) {
+            phase_filters(taps_per_phase - 1 - k, p) = static_cast<float>(prototype[k * up + p]);
+        }
+    }
+}
+
+void PolyphaseResampler::Reset() {
+    history.assign(IsPassthrough() ? 0 : taps_per_phase - 1, 0.0f);
+    next_base = history.size();
+    next_phase = 0;
+}
+
+void PolyphaseResampler::Process(const float* interleaved, size_t num_frames, std::vector<float>& out) {
+    if (num_frames == 0) {
+        return;
+    }
+
+    const Eigen::Index frames = static_cast<Eigen::Index>(num_frames);
+    Eigen::Map<const Eigen::MatrixXf> input(interleaved, channels, frames);
+
+    // 같은 레이트면 다운믹스만 수행
+    if (IsPassthrough()) {
+        size_t offset = out.size();
+        out.resize(offset + num_frames);
+        Eigen::Map<Eigen::RowVectorXf> mono(out.data() + offset, frames);
+        if (channels == 1) {
+            mono = input;
+        } else {
+            mono = input.colwise().mean();
+        }
+        return;
+    }
+
+    // 다운믹스 결과를 히스토리 뒤에 바로 기록 (중간 버퍼 없음)
+    size_t history_offset = history.size();
+    history.resize(history_offset + num_frames);
+    Eigen::Map<Eigen::RowVectorXf> mono(history.data() + history_offset, frames);
+    if (channels == 1) {
+        mono = input;
+    } else {
+        mono = input.colwise().mean();
+    }
+
+    // 출력 샘플마다 해당 위상 필터와 최근 K개 입력을 내적
+    const size_t K = static_cast<size_t>(taps_per_phase);
+    const size_t available = history.size();
+    out.reserve(out.size() + (num_frames * up) / down + 1);
+
+    while (next_base < available) {
+        Eigen::Map<const Eigen::VectorXf> window(history.data() + next_base + 1 - K, taps_per_phase);
+        out.push_back(window.dot(phase_filters.col(next_phase)));
+
+        next_phase += down;
+        next_base += next_phase / up;
+        next_phase %= up;
+    }
+
+    // 다음 호출을 위해 필요한 K-1개의 히스토리만 남긴다
+    size_t keep_from = next_base + 1 - K;
+    if (keep_from > 0) {
+        keep_from = std::min(keep_from, history.size());
+        history.erase(history.begin(), history.begin() + keep_from);
+        next_base -= keep_from;
+    }
+}
+
+} // namespace realtime_engine_ko
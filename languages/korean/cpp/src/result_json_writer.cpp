@@ -0,0 +1,366 @@
+// src/cpp/src/result_json_writer.cpp
+#include "realtime_engine_ko/result_json_writer.h"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+// nlohmann::json::dump()의 실수 표기 규칙을 따른다: 10^-5 < |v| < 10^15는 고정 소수점 (정수 값이면 ".0"),
+// 그 밖은 "d.ddde+XX" 지수 표기. 자릿수는 내부 API(detail::to_chars) 대신 std::to_chars의 최단 왕복 표현이라
+// 17자리 반올림 경계값에서 마지막 자리가 Grisu2와 다를 수 있다 (읽으면 같은 double)
+void AppendShortestDouble(std::string& out, double value) {
+    if (std::signbit(value)) {
+        out += '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        out += "0.0";
+        return;
+    }
+
+    // 최단 왕복 자릿수를 과학 표기로 받아 자릿수/지수로 분해 ("d.ddde±XX")
+    char scientific[64];
+    auto [sci_end, ec] = std::to_chars(scientific, scientific + sizeof(scientific), value,
+                                       std::chars_format::scientific);
+    char digits[32];
+    int num_digits = 0;
+    const char* p = scientific;
+    for (; p < sci_end && *p != 'e'; ++p) {
+        if (*p != '.') {
+            digits[num_digits++] = *p;
+        }
+    }
+    // 첫 자릿수 기준 10의 지수 (to_chars 출력은 NUL 종료되지 않으므로 sci_end까지만 읽는다)
+    bool negative_exponent = p + 1 < sci_end && p[1] == '-';
+    int exponent = 0;
+    std::from_chars(p + 2, sci_end, exponent);
+    if (negative_exponent) {
+        exponent = -exponent;
+    }
+
+    constexpr int kMinExp = -4;
+    constexpr int kMaxExp = 15;
+    const int k = num_digits;
+    const int n = exponent + 1;  // 소수점 위치 (digits × 10^(n-k))
+
+    if (k <= n && n <= kMaxExp) {
+        // 정수: 123e2 → 12300.0
+        out.append(digits, k);
+        out.append(static_cast<size_t>(n - k), '0');
+        out += ".0";
+    } else if (0 < n && n <= kMaxExp) {
+        // 소수점이 자릿수 사이: 1234e-2 → 12.34
+        out.append(digits, n);
+        out += '.';
+        out.append(digits + n, k - n);
+    } else if (kMinExp < n && n <= 0) {
+        // 0.[0...]ddd: 1234e-6 → 0.001234
+        out += "0.";
+        out.append(static_cast<size_t>(-n), '0');
+        out.append(digits, k);
+    } else {
+        // 지수 표기: d[.ddd]e±XX (지수는 최소 두 자리)
+        out += digits[0];
+        if (k > 1) {
+            out += '.';
+            out.append(digits + 1, k - 1);
+        }
+        int e = n - 1;
+        out += e < 0 ? "e-" : "e+";
+        e = std::abs(e);
+        if (e < 10) {
+            out += '0';
+        }
+        out += std::to_string(e);
+    }
+}
+
+} // namespace
+
+// 키는 모두 nlohmann::json 객체(std::map)와 같은 사전순으로 기록한다.
+
+ResultJsonWriter::ResultJsonWriter(size_t initial_capacity) {
+    buffer.reserve(initial_capacity);
+}
+
+const std::string& ResultJsonWriter::Write(const EvaluationResult& result) {
+    buffer.clear();  // capacity는 유지되므로 이후 호출은 힙 할당이 없다
+    buffer += "{\"result\":";
+    WriteResultObject(result);
+    buffer += '}';
+    return buffer;
+}
+
+const std::string& ResultJsonWriter::Write(const EngineState& state) {
+    buffer.clear();
+    buffer += '{';
+
+    if (state.initialized) {
+        if (state.audio.has_value()) {
+            WriteKey("audio");
+            buffer += '{';
+            WriteKey("silent_chunks");
+            WriteInt(state.audio->silent_chunks);
+            buffer += ',';
+            WriteKey("total_chunks");
+            WriteInt(state.audio->total_chunks);
+            buffer += "},";
+        }
+
+        if (state.summary.has_value()) {
+            WriteSummaryFields(state.summary.value());
+        } else {
+            WriteKey("progress");
+            buffer += '{';
+            WriteKey("current");
+            WriteInt(state.current_block);
+            buffer += ',';
+            WriteKey("total");
+            WriteUInt(state.total_blocks);
+            buffer += "},";
+        }
+
+        if (state.result.has_value()) {
+            WriteKey("result");
+            WriteResultObject(state.result.value());
+            buffer += ',';
+        }
+    }
+
+    WriteKey("status");
+    WriteString(state.status);
+    buffer += '}';
+    return buffer;
+}
+
+const std::string& ResultJsonWriter::Write(const ScoreDelta& delta) {
+    buffer.clear();
+    buffer += '{';
+
+    WriteKey("blocks");
+    buffer += '[';
+    for (size_t i = 0; i < delta.blocks.size(); ++i) {
+        if (i > 0) {
+            buffer += ',';
+        }
+        WriteBlock(delta.blocks[i]);
+    }
+    buffer += "],";
+
+    WriteKey("completed");
+    WriteUInt(delta.completed);
+    buffer += ',';
+    WriteKey("eof");
+    WriteBool(delta.eof);
+    buffer += ',';
+    WriteKey("overall");
+    WriteFloat(delta.overall);
+    buffer += ',';
+    WriteKey("pronunciation");
+    WriteFloat(delta.pronunciation);
+    buffer += ',';
+    WriteKey("seq");
+    WriteUInt(delta.seq);
+    buffer += ',';
+    WriteKey("total");
+    WriteUInt(delta.total);
+    buffer += ',';
+    WriteKey("type");
+    buffer += delta.snapshot ? "\"snapshot\"" : "\"delta\"";
+    buffer += '}';
+    return buffer;
+}
+
+const std::string& ResultJsonWriter::Write(const BlockResult& block) {
+    buffer.clear();
+    WriteBlock(block);
+    return buffer;
+}
+
+void ResultJsonWriter::WriteResultObject(const EvaluationResult& result) {
+    buffer += '{';
+
+    if (result.details.has_value()) {
+        const auto& details = result.details.value();
+        WriteKey("details");
+        buffer += '{';
+        WriteKey("completion_time");
+        WriteInt(static_cast<int64_t>(details.completion_time));
+        buffer += ',';
+        WriteKey("score_breakdown");
+        buffer += '{';
+        WriteKey("max_score");
+        WriteFloat(details.score_breakdown.max_score);
+        buffer += ',';
+        WriteKey("min_score");
+        WriteFloat(details.score_breakdown.min_score);
+        buffer += "},";
+        WriteKey("total_blocks");
+        WriteUInt(details.total_blocks);
+        buffer += "},";
+    }
+
+    WriteKey("eof");
+    WriteBool(result.eof);
+    buffer += ',';
+
+    if (result.final_score.has_value()) {
+        WriteKey("final_score");
+        WriteFloat(result.final_score.value());
+        buffer += ',';
+    }
+
+    WriteKey("overall");
+    WriteFloat(result.overall);
+    buffer += ',';
+    WriteKey("pronunciation");
+    WriteFloat(result.pronunciation);
+    buffer += ',';
+    WriteKey("resource_version");
+    WriteString(result.resource_version);
+    buffer += ',';
+
+    WriteKey("words");
+    buffer += '[';
+    for (size_t i = 0; i < result.words.size(); ++i) {
+        if (i > 0) {
+            buffer += ',';
+        }
+        buffer += '{';
+        WriteKey("scores");
+        buffer += '{';
+        WriteKey("pronunciation");
+        WriteFloat(result.words[i].pronunciation);
+        buffer += "},";
+        WriteKey("word");
+        WriteString(result.words[i].word);
+        buffer += '}';
+    }
+    buffer += "]}";
+}
+
+void ResultJsonWriter::WriteSummaryFields(const EvaluationSummary& summary) {
+    // "blocks" < "overall_score" < "progress" (뒤에 result/status가 이어진다)
+    WriteKey("blocks");
+    buffer += '[';
+    for (size_t i = 0; i < summary.blocks.size(); ++i) {
+        if (i > 0) {
+            buffer += ',';
+        }
+        WriteBlock(summary.blocks[i]);
+    }
+    buffer += "],";
+
+    WriteKey("overall_score");
+    WriteFloat(summary.overall_score);
+    buffer += ',';
+
+    WriteKey("progress");
+    buffer += '{';
+    WriteKey("completed");
+    WriteUInt(summary.completed);
+    buffer += ',';
+    WriteKey("total");
+    WriteUInt(summary.total);
+    buffer += "},";
+}
+
+void ResultJsonWriter::WriteBlock(const BlockResult& block) {
+    buffer += '{';
+    WriteKey("block_id");
+    WriteInt(block.block_id);
+    buffer += ',';
+
+    if (block.confidence.has_value()) {
+        WriteKey("confidence");
+        WriteFloat(block.confidence.value());
+        buffer += ',';
+    }
+    if (block.evaluated_at.has_value()) {
+        WriteKey("evaluated_at");
+        WriteFloat(block.evaluated_at.value());
+        buffer += ',';
+    }
+    if (block.gop_score.has_value()) {
+        WriteKey("gop_score");
+        WriteFloat(block.gop_score.value());
+        buffer += ',';
+    }
+    if (block.recognized_at.has_value()) {
+        WriteKey("recognized_at");
+        WriteFloat(block.recognized_at.value());
+        buffer += ',';
+    }
+
+    WriteKey("status");
+    WriteString(block.status);
+    buffer += ',';
+    WriteKey("text");
+    WriteString(block.text);
+    buffer += '}';
+}
+
+void ResultJsonWriter::WriteKey(const char* key) {
+    // 키는 이스케이프가 필요 없는 고정 ASCII 문자열
+    buffer += '"';
+    buffer += key;
+    buffer += "\":";
+}
+
+void ResultJsonWriter::WriteString(const std::string& value) {
+    static const char* hex_digits = "0123456789abcdef";
+
+    buffer += '"';
+    for (char c : value) {
+        switch (c) {
+            case '\b': buffer += "\\b"; break;
+            case '\t': buffer += "\\t"; break;
+            case '\n': buffer += "\\n"; break;
+            case '\f': buffer += "\\f"; break;
+            case '\r': buffer += "\\r"; break;
+            case '"':  buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    // 나머지 제어 문자는 nlohmann과 같이 소문자 \u00xx
+                    buffer += "\\u00";
+                    buffer += hex_digits[(c >> 4) & 0x0F];
+                    buffer += hex_digits[c & 0x0F];
+                } else {
+                    buffer += c;  // UTF-8 바이트는 그대로 (ensure_ascii=false)
+                }
+                break;
+        }
+    }
+    buffer += '"';
+}
+
+void ResultJsonWriter::WriteFloat(double value) {
+    if (!std::isfinite(value)) {
+        buffer += "null";
+        return;
+    }
+
+    AppendShortestDouble(buffer, value);
+}
+
+void ResultJsonWriter::WriteInt(int64_t value) {
+    char digits[24];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, end);
+}
+
+void ResultJsonWriter::WriteUInt(uint64_t value) {
+    char digits[24];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, end);
+}
+
+void ResultJsonWriter::WriteBool(bool value) {
+    buffer += value ? "true" : "false";
+}
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,233 @@
+// src/cpp/src/result_msgpack_writer.cpp
+#include "realtime_engine_ko/result_msgpack_writer.h"
+#include <msgpack.hpp>
+#include <cstdint>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+// msgpack::packer가 요구하는 write(const char*, size_t) 스트림 - 재사용 버퍼에 이어 쓴다
+struct BufferStream {
+    std::string& out;
+    void write(const char* data, size_t size) { out.append(data, size); }
+};
+
+using Packer = msgpack::packer<BufferStream>;
+
+void PackKey(Packer& pk, const char* key, size_t length) {
+    pk.pack_str(static_cast<uint32_t>(length));
+    pk.pack_str_body(key, static_cast<uint32_t>(length));
+}
+
+template <size_t N>
+void PackKey(Packer& pk, const char (&key)[N]) {
+    PackKey(pk, key, N - 1);
+}
+
+void PackString(Packer& pk, const std::string& value) {
+    PackKey(pk, value.data(), value.size());
+}
+
+void PackResultObject(Packer& pk, const EvaluationResult& result) {
+    pk.pack_map(5 + (result.details.has_value() ? 1 : 0) + (result.final_score.has_value() ? 1 : 0));
+
+    if (result.details.has_value()) {
+        const auto& details = result.details.value();
+        PackKey(pk, "details");
+        pk.pack_map(3);
+        PackKey(pk, "completion_time");
+        pk.pack_int64(static_cast<int64_t>(details.completion_time));
+        PackKey(pk, "score_breakdown");
+        pk.pack_map(2);
+        PackKey(pk, "max_score");
+        pk.pack_float(details.score_breakdown.max_score);
+        PackKey(pk, "min_score");
+        pk.pack_float(details.score_breakdown.min_score);
+        PackKey(pk, "total_blocks");
+        pk.pack_uint64(details.total_blocks);
+    }
+
+    PackKey(pk, "eof");
+    result.eof ? pk.pack_true() : pk.pack_false();
+
+    if (result.final_score.has_value()) {
+        PackKey(pk, "final_score");
+        pk.pack_float(result.final_score.value());
+    }
+
+    PackKey(pk, "overall");
+    pk.pack_float(result.overall);
+    PackKey(pk, "pronunciation");
+    pk.pack_float(result.pronunciation);
+    PackKey(pk, "resource_version");
+    PackString(pk, result.resource_version);
+
+    PackKey(pk, "words");
+    pk.pack_array(static_cast<uint32_t>(result.words.size()));
+    for (const auto& word : result.words) {
+        pk.pack_map(2);
+        PackKey(pk, "scores");
+        pk.pack_map(1);
+        PackKey(pk, "pronunciation");
+        pk.pack_float(word.pronunciation);
+        PackKey(pk, "word");
+        PackString(pk, word.word);
+    }
+}
+
+void PackBlock(Packer& pk, const BlockResult& block) {
+    pk.pack_map(3 + (block.confidence.has_value() ? 1 : 0) + (block.evaluated_at.has_value() ? 1 : 0) +
+                (block.gop_score.has_value() ? 1 : 0) + (block.recognized_at.has_value() ? 1 : 0));
+
+    PackKey(pk, "block_id");
+    pk.pack_int32(block.block_id);
+    if (block.confidence.has_value()) {
+        PackKey(pk, "confidence");
+        pk.pack_float(block.confidence.value());
+    }
+    if (block.evaluated_at.has_value()) {
+        PackKey(pk, "evaluated_at");
+        pk.pack_double(block.evaluated_at.value());
+    }
+    if (block.gop_score.has_value()) {
+        PackKey(pk, "gop_score");
+        pk.pack_float(block.gop_score.value());
+    }
+    if (block.recognized_at.has_value()) {
+        PackKey(pk, "recognized_at");
+        pk.pack_double(block.recognized_at.value());
+    }
+    PackKey(pk, "status");
+    PackString(pk, block.status);
+    PackKey(pk, "text");
+    PackString(pk, block.text);
+}
+
+void PackBlocks(Packer& pk, const std::vector<BlockResult>& blocks) {
+    pk.pack_array(static_cast<uint32_t>(blocks.size()));
+    for (const auto& block : blocks) {
+        PackBlock(pk, block);
+    }
+}
+
+} // namespace
+
+ResultMsgpackWriter::ResultMsgpackWriter(size_t initial_capacity) {
+    buffer.reserve(initial_capacity);
+}
+
+void ResultMsgpackWriter::Begin() {
+    // capacity는 유지되므로 이후 호출은 힙 할당이 없다. 길이 자리는 Finish에서 채운다.
+    buffer.assign(kLengthPrefixSize, '\0');
+}
+
+const std::string& ResultMsgpackWriter::Finish() {
+    uint32_t length = static_cast<uint32_t>(buffer.size() - kLengthPrefixSize);
+    buffer[0] = static_cast<char>((length >> 24) & 0xFF);
+    buffer[1] = static_cast<char>((length >> 16) & 0xFF);
+    buffer[2] = static_cast<char>((length >> 8) & 0xFF);
+    buffer[3] = static_cast<char>(length & 0xFF);
+    return buffer;
+}
+
+const std::string& ResultMsgpackWriter::Write(const EvaluationResult& result) {
+    Begin();
+    BufferStream stream{buffer};
+    Packer pk(stream);
+
+    pk.pack_map(1);
+    PackKey(pk, "result");
+    PackResultObject(pk, result);
+
+    return Finish();
+}
+
+const std::string& ResultMsgpackWriter::Write(const EngineState& state) {
+    Begin();
+    BufferStream stream{buffer};
+    Packer pk(stream);
+
+    if (!state.initialized) {
+        pk.pack_map(1);
+        PackKey(pk, "status");
+        PackString(pk, state.status);
+        return Finish();
+    }
+
+    // status, progress + (audio) + (summary: blocks, overall_score) + (result)
+    pk.pack_map(2 + (state.audio.has_value() ? 1 : 0) + (state.summary.has_value() ? 2 : 0) +
+                (state.result.has_value() ? 1 : 0));
+
+    if (state.audio.has_value()) {
+        PackKey(pk, "audio");
+        pk.pack_map(2);
+        PackKey(pk, "silent_chunks");
+        pk.pack_int32(state.audio->silent_chunks);
+        PackKey(pk, "total_chunks");
+        pk.pack_int32(state.audio->total_chunks);
+    }
+
+    if (state.summary.has_value()) {
+        const auto& summary = state.summary.value();
+        PackKey(pk, "blocks");
+        PackBlocks(pk, summary.blocks);
+        PackKey(pk, "overall_score");
+        pk.pack_float(summary.overall_score);
+        PackKey(pk, "progress");
+        pk.pack_map(2);
+        PackKey(pk, "completed");
+        pk.pack_uint64(summary.completed);
+        PackKey(pk, "total");
+        pk.pack_uint64(summary.total);
+    } else {
+        PackKey(pk, "progress");
+        pk.pack_map(2);
+        PackKey(pk, "current");
+        pk.pack_int32(state.current_block);
+        PackKey(pk, "total");
+        pk.pack_uint64(state.total_blocks);
+    }
+
+    if (state.result.has_value()) {
+        PackKey(pk, "result");
+        PackResultObject(pk, state.result.value());
+    }
+
+    PackKey(pk, "status");
+    PackString(pk, state.status);
+
+    return Finish();
+}
+
+const std::string& ResultMsgpackWriter::Write(const ScoreDelta& delta) {
+    Begin();
+    BufferStream stream{buffer};
+    Packer pk(stream);
+
+    pk.pack_map(8);
+    PackKey(pk, "blocks");
+    PackBlocks(pk, delta.blocks);
+    PackKey(pk, "completed");
+    pk.pack_uint64(delta.completed);
+    PackKey(pk, "eof");
+    delta.eof ? pk.pack_true() : pk.pack_false();
+    PackKey(pk, "overall");
+    pk.pack_float(delta.overall);
+    PackKey(pk, "pronunciation");
+    pk.pack_float(delta.pronunciation);
+    PackKey(pk, "seq");
+    pk.pack_uint64(delta.seq);
+    PackKey(pk, "total");
+    pk.pack_uint64(delta.total);
+    PackKey(pk, "type");
+    if (delta.snapshot) {
+        PackKey(pk, "snapshot");
+    } else {
+        PackKey(pk, "delta");
+    }
+
+    return Finish();
+}
+
+} // namespace realtime_engine_ko
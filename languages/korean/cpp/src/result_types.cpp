@@ -0,0 +1,147 @@
+// src/cpp/src/result_types.cpp
+#include "realtime_engine_ko/result_types.h"
+
+namespace realtime_engine_ko {
+
+std::map<std::string, std::any> ToMap(const WordScore& word, bool integral_score) {
+    std::map<std::string, std::any> word_map;
+    word_map["word"] = word.word;
+
+    // GOP 단어 점수는 정수, 블록 점수는 소수점 첫째 자리 실수로 내보낸다
+    std::map<std::string, std::any> scores_map;
+    if (integral_score) {
+        scores_map["pronunciation"] = static_cast<int>(word.pronunciation);
+    } else {
+        scores_map["pronunciation"] = word.pronunciation;
+    }
+    word_map["scores"] = scores_map;
+
+    return word_map;
+}
+
+std::map<std::string, std::any> ToMap(const GopResult& result) {
+    std::vector<std::map<std::string, std::any>> words;
+    words.reserve(result.words.size());
+    for (const auto& word : result.words) {
+        words.push_back(ToMap(word, true));
+    }
+
+    std::map<std::string, std::any> result_map;
+    result_map["overall"] = result.overall;
+    result_map["pronunciation"] = result.pronunciation;
+    result_map["words"] = words;
+    return result_map;
+}
+
+std::map<std::string, std::any> ToMap(const BlockResult& block) {
+    std::map<std::string, std::any> result;
+    result["text"] = block.text;
+    result["block_id"] = block.block_id;
+    result["status"] = block.status;
+
+    // 선택적 값들
+    if (block.gop_score.has_value()) {
+        result["gop_score"] = block.gop_score.value();
+    }
+    if (block.confidence.has_value()) {
+        result["confidence"] = block.confidence.value();
+    }
+    if (block.recognized_at.has_value()) {
+        result["recognized_at"] = block.recognized_at.value();
+    }
+    if (block.evaluated_at.has_value()) {
+        result["evaluated_at"] = block.evaluated_at.value();
+    }
+
+    return result;
+}
+
+std::map<std::string, std::any> ToMap(const EvaluationResult& result) {
+    std::vector<std::map<std::string, std::any>> words;
+    words.reserve(result.words.size());
+    for (const auto& word : result.words) {
+        words.push_back(ToMap(word, false));
+    }
+
+    std::map<std::string, std::any> inner_result;
+    inner_result["overall"] = result.overall;
+    inner_result["pronunciation"] = result.pronunciation;
+    inner_result["resource_version"] = result.resource_version;
+    inner_result["words"] = words;
+    inner_result["eof"] = result.eof;
+
+    if (result.final_score.has_value()) {
+        inner_result["final_score"] = result.final_score.value();
+    }
+
+    if (result.details.has_value()) {
+        const auto& details = result.details.value();
+
+        std::map<std::string, std::any> score_breakdown;
+        score_breakdown["min_score"] = details.score_breakdown.min_score;
+        score_breakdown["max_score"] = details.score_breakdown.max_score;
+
+        std::map<std::string, std::any> details_map;
+        details_map["total_blocks"] = details.total_blocks;
+        details_map["completion_time"] = details.completion_time;
+        details_map["score_breakdown"] = score_breakdown;
+        inner_result["details"] = details_map;
+    }
+
+    return inner_result;
+}
+
+std::map<std::string, std::any> ToMap(const EvaluationSummary& summary) {
+    std::map<std::string, std::any> summary_map;
+    summary_map["overall_score"] = summary.overall_score;
+
+    std::map<std::string, std::any> progress;
+    progress["completed"] = summary.completed;
+    progress["total"] = summary.total;
+    summary_map["progress"] = progress;
+
+    std::vector<std::map<std::string, std::any>> blocks;
+    blocks.reserve(summary.blocks.size());
+    for (const auto& block : summary.blocks) {
+        blocks.push_back(ToMap(block));
+    }
+    summary_map["blocks"] = blocks;
+
+    return summary_map;
+}
+
+std::map<std::string, std::any> ToMap(const EngineState& state) {
+    std::map<std::string, std::any> result;
+    result["status"] = state.status;
+
+    if (!state.initialized) {
+        return result;
+    }
+
+    std::map<std::string, std::any> progress;
+    progress["current"] = state.current_block;
+    progress["total"] = state.total_blocks;
+    result["progress"] = progress;
+
+    if (state.audio.has_value()) {
+        std::map<std::string, std::any> audio;
+        audio["total_chunks"] = state.audio->total_chunks;
+        audio["silent_chunks"] = state.audio->silent_chunks;
+        result["audio"] = audio;
+    }
+
+    // 요약 키를 최상위에 병합 (progress는 요약의 completed/total로 대체된다)
+    if (state.summary.has_value()) {
+        for (auto& [key, value] : ToMap(state.summary.value())) {
+            result[key] = std::move(value);
+        }
+    }
+
+    if (state.result.has_value()) {
+        result["result"] = ToMap(state.result.value());
+    }
+
+    return result;
+}
+
+} // namespace realtime_engine_ko
@@ -10,65 +10,69 @@ namespace realtime_engine_ko {
 SentenceBlock::SentenceBlock(const std::string& text, int block_id)
     : text(text), block_id(block_id), status(BlockStatus::PENDING),
       gop_score(std::nullopt), confidence(std::nullopt),
-      recognized_at(std::nullopt), evaluated_at(std::nullopt) {
+      recognized_at(std::nullopt), evaluated_at(std::nullopt), revision(0) {
 }
 
 void SentenceBlock::SetStatus(BlockStatus status) {
-    this->status = status;
+    if (this->status != status) {
+        this->status = status;
+        revision++;
+    }
 }
 
 void SentenceBlock::SetScore(float score) {
-    this->gop_score = score;
+    if (this->gop_score != score) {
+        this->gop_score = score;
+        revision++;
+    }
 }
 
 void SentenceBlock::SetConfidence(float confidence) {
-    this->confidence = confidence;
+    if (this->confidence != confidence) {
+        this->confidence = confidence;
+        revision++;
+    }
 }
 
-std::map<std::string, std::any> SentenceBlock::ToDict() const {
-    std::map<std::string, std::any> result;
+BlockResult SentenceBlock::ToResult() const {
+    BlockResult result;
     
-    result["text"] = text;
-    result["block_id"] = block_id;
+    result.text = text;
+    result.block_id = block_id;
     
     // 상태를 문자열로 변환
-    std::string status_str;
     switch (status) {
-        case BlockStatus::PENDING:    status_str = "pending"; break;
-        case BlockStatus::ACTIVE:     status_str = "active"; break;
-        case BlockStatus::RECOGNIZED: status_str = "recognized"; break;
-        case BlockStatus::EVALUATED:  status_str = "evaluated"; break;
+        case BlockStatus::PENDING:    result.status = "pending"; break;
+        case BlockStatus::ACTIVE:     result.status = "active"; break;
+        case BlockStatus::RECOGNIZED: result.status = "recognized"; break;
+        case BlockStatus::EVALUATED:  result.status = "evaluated"; break;
     }
-    result["status"] = status_str;
     
     // 선택적 값들
-    if (gop_score.has_value()) {
-        result["gop_score"] = gop_score.value();
-    }
-    if (confidence.has_value()) {
-        result["confidence"] = confidence.value();
-    }
+    result.gop_score = gop_score;
+    result.confidence = confidence;
     
     // 시간 정보 (epoch 시간으로 변환)
     if (recognized_at.has_value()) {
-        auto time_point = recognized_at.value();
-        auto duration = time_point.time_since_epoch();
-        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
-        result["recognized_at"] = static_cast<double>(seconds);
+        auto duration = recognized_at.value().time_since_epoch();
+        result.recognized_at = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::seconds>(duration).count());
     }
     if (evaluated_at.has_value()) {
-        auto time_point = evaluated_at.value();
-        auto duration = time_point.time_since_epoch();
-        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
-        result["evaluated_at"] = static_cast<double>(seconds);
+        auto duration = evaluated_at.value().time_since_epoch();
+        result.evaluated_at = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::seconds>(duration).count());
     }
     
     return result;
 }
 
+std::map<std::string, std::any> SentenceBlock::ToDict() const {
+    return ToMap(ToResult());
+}
+
 // SentenceBlockManager 구현
-SentenceBlockManager::SentenceBlockManager(const std::string& sentence, const std::string& delimiter)
-    : active_block_id(0) {
+std::vector<std::string> SentenceBlockManager::SplitBlocks(const std::string& sentence, const std::string& delimiter) {
     // 문자열 분할 함수
     auto split = [](const std::string& str, const std::string& delim) -> std::vector<std::string> {
         std::vector<std::string> tokens;
@@ -85,21 +89,35 @@ SentenceBlockManager::SentenceBlockManager(const std::string& sentence, const st
     
     // 문장을 블록으로 분할
     std::vector<std::string> blocks_text = split(sentence, delimiter);
-    for (size_t i = 0; i < blocks_text.size(); ++i) {
-        std::string& block_text = blocks_text[i];
-        
+    std::vector<std::string> result;
+    result.reserve(blocks_text.size());
+    for (auto& block_text : blocks_text) {
         // 앞뒤 공백 제거
         block_text.erase(0, block_text.find_first_not_of(" \t\n\r\f\v"));
         block_text.erase(block_text.find_last_not_of(" \t\n\r\f\v") + 1);
         
         if (!block_text.empty()) {
-            blocks.push_back(std::make_shared<SentenceBlock>(block_text, static_cast<int>(i)));
+            result.push_back(std::move(block_text));
         }
     }
+    return result;
+}
+
+SentenceBlockManager::SentenceBlockManager(const std::string& sentence, const std::string& delimiter)
+    : SentenceBlockManager(SplitBlocks(sentence, delimiter)) {
+}
+
+SentenceBlockManager::SentenceBlockManager(const std::vector<std::string>& block_texts)
+    : active_block_id(0) {
+    blocks.reserve(block_texts.size());
+    for (size_t i = 0; i < block_texts.size(); ++i) {
+        blocks.push_back(std::make_shared<SentenceBlock>(block_texts[i], static_cast<int>(i)));
+    }
     
     // 첫 번째 블록은 ACTIVE 상태로 설정
     if (!blocks.empty()) {
         blocks[0]->SetStatus(BlockStatus::ACTIVE);
+        Touch(0);
     }
     
     std::stringstream ss;
@@ -119,7 +137,7 @@ std::shared_ptr<SentenceBlock> SentenceBlockManager::GetActiveBlock() const {
 }
 
 bool SentenceBlockManager::SetActiveBlock(int block_id) {
-    if (block_id < 0 || block_id >= static_cast<int>(blocks.size())) {
+    if (!GetBlock(block_id)) {
         return false;
     }
     
@@ -132,6 +150,7 @@ bool SentenceBlockManager::SetActiveBlock(int block_id) {
     // 새 활성 블록 설정
     active_block_id = block_id;
     blocks[block_id]->SetStatus(BlockStatus::ACTIVE);
+    Touch(block_id);
     
     std::stringstream ss;
     ss << "활성 블록 변경: " << block_id;
@@ -151,7 +170,9 @@ std::vector<std::shared_ptr<SentenceBlock>> SentenceBlockManager::GetWindow(int
     
     std::vector<std::shared_ptr<SentenceBlock>> result;
     for (int i = start; i < end && i < static_cast<int>(blocks.size()); ++i) {
-        result.push_back(blocks[i]);
+        if (blocks[i]) {
+            result.push_back(blocks[i]);
+        }
     }
     
     return result;
@@ -163,7 +184,25 @@ bool SentenceBlockManager::UpdateBlockStatus(int block_id, BlockStatus status) {
         return false;
     }
     
+    // 평가 완료로 들어오거나 나가는 블록만 집계에 반영
+    bool was_evaluated = block->status == BlockStatus::EVALUATED;
+    bool is_evaluated = status == BlockStatus::EVALUATED;
+    if (!was_evaluated && is_evaluated && block->gop_score.has_value()) {
+        float score = block->gop_score.value();
+        aggregates.completed++;
+        aggregates.score_sum += score;
+        aggregates.min_score = std::min(aggregates.min_score, score);
+        aggregates.max_score = std::max(aggregates.max_score, score);
+        aggregates.last_evaluated = std::max(aggregates.last_evaluated, block_id);
+    } else if (was_evaluated && !is_evaluated && block->gop_score.has_value()) {
+        aggregates.completed--;
+        aggregates.score_sum -= block->gop_score.value();
+        block->SetStatus(status);
+        RecomputeMinMax();
+    }
+    
     block->SetStatus(status);
+    Touch(block_id);
     if (status == BlockStatus::RECOGNIZED) {
         block->recognized_at = std::chrono::system_clock::now();
     }
@@ -180,25 +219,115 @@ bool SentenceBlockManager::SetBlockScore(int block_id, float score) {
         return false;
     }
     
-    block->SetScore(score);
+    // 이미 평가된 블록의 점수가 바뀌면 합계를 고치고, 최소/최대였다면 상주 블록에서 다시 구한다
+    if (block->status == BlockStatus::EVALUATED && block->gop_score.has_value() && block->gop_score != score) {
+        float old_score = block->gop_score.value();
+        aggregates.score_sum += score - old_score;
+        block->SetScore(score);
+        if (old_score <= aggregates.min_score || old_score >= aggregates.max_score) {
+            RecomputeMinMax();
+        } else {
+            aggregates.min_score = std::min(aggregates.min_score, score);
+            aggregates.max_score = std::max(aggregates.max_score, score);
+        }
+    } else {
+        block->SetScore(score);
+    }
+    Touch(block_id);
     return true;
 }
 
+void SentenceBlockManager::Touch(int block_id) {
+    touched_end = std::max(touched_end, block_id + 1);
+}
+
+void SentenceBlockManager::RecomputeMinMax() {
+    aggregates.min_score = spilled_min;
+    aggregates.max_score = spilled_max;
+    for (int i = spill_frontier; i < touched_end; ++i) {
+        const auto& block = blocks[i];
+        if (block && block->status == BlockStatus::EVALUATED && block->gop_score.has_value()) {
+            aggregates.min_score = std::min(aggregates.min_score, block->gop_score.value());
+            aggregates.max_score = std::max(aggregates.max_score, block->gop_score.value());
+        }
+    }
+}
+
+void SentenceBlockManager::SetResidency(size_t resident_blocks) {
+    this->resident_blocks = resident_blocks;
+    
+    std::stringstream ss;
+    ss << "장문 모드 상주 블록 수: " << resident_blocks;
+    LOG_INFO("SentenceBlockManager", ss.str());
+}
+
+std::vector<BlockResult> SentenceBlockManager::SpillFinalized() {
+    std::vector<BlockResult> spilled;
+    if (resident_blocks == 0) {
+        return spilled;
+    }
+    
+    // 활성 윈도우는 활성 블록 앞쪽만 보므로 resident_blocks 이상 뒤처진 블록은 다시 바뀌지 않는다
+    int spill_end = std::min(active_block_id - static_cast<int>(resident_blocks),
+                             static_cast<int>(blocks.size()));
+    for (; spill_frontier < spill_end; ++spill_frontier) {
+        auto& block = blocks[spill_frontier];
+        spilled.push_back(block->ToResult());
+        if (block->status == BlockStatus::EVALUATED && block->gop_score.has_value()) {
+            spilled_min = std::min(spilled_min, block->gop_score.value());
+            spilled_max = std::max(spilled_max, block->gop_score.value());
+        }
+        spilled_texts.push_back(std::move(block->text));
+        block.reset();
+    }
+    return spilled;
+}
+
+std::vector<BlockResult> SentenceBlockManager::GetAllBlockResults() const {
+    return GetBlockResults(0, static_cast<int>(blocks.size()));
+}
+
+std::vector<BlockResult> SentenceBlockManager::GetBlockResults(int begin, int end) const {
+    begin = std::max(begin, spill_frontier);
+    end = std::min(end, static_cast<int>(blocks.size()));
+    
+    std::vector<BlockResult> result;
+    result.reserve(std::max(0, end - begin));
+    for (int i = begin; i < end; ++i) {
+        result.push_back(blocks[i]->ToResult());
+    }
+    return result;
+}
+
 std::vector<std::map<std::string, std::any>> SentenceBlockManager::GetAllBlocksStatus() const {
     std::vector<std::map<std::string, std::any>> result;
     for (const auto& block : blocks) {
-        result.push_back(block->ToDict());
+        if (block) {
+            result.push_back(block->ToDict());
+        }
     }
     return result;
 }
 
 void SentenceBlockManager::Reset() {
+    // 내려진 블록을 다시 만든다 (revision은 아래에서 올라가므로 델타 이벤트에 포함된다)
+    for (size_t i = 0; i < spilled_texts.size(); ++i) {
+        blocks[i] = std::make_shared<SentenceBlock>(spilled_texts[i], static_cast<int>(i));
+    }
+    spilled_texts.clear();
+    spill_frontier = 0;
+    spilled_min = std::numeric_limits<float>::max();
+    spilled_max = -std::numeric_limits<float>::max();
+    aggregates = Aggregates();
+    touched_end = static_cast<int>(blocks.size());
+    
     for (auto& block : blocks) {
         block->SetStatus(BlockStatus::PENDING);
         block->gop_score = std::nullopt;
         block->confidence = std::nullopt;
         block->recognized_at = std::nullopt;
         block->evaluated_at = std::nullopt;
+        block->revision++;
     }
     
     // 첫 번째 블록을 활성화
@@ -0,0 +1,166 @@
+// src/cpp/src/sentence_plan.cpp
+#include "realtime_engine_ko/sentence_plan.h"
+#include "realtime_engine_ko/w2v_onnx_core.h"
+#include "realtime_engine_ko/common.h"
+#include <algorithm>
+#include <sstream>
+#include <cctype>
+#include <stdexcept>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+int CountWords(const std::string& text) {
+    int count = 0;
+    std::istringstream iss(text);
+    std::string word;
+    while (iss >> word) {
+        count++;
+    }
+    return count;
+}
+
+std::string JoinBlocks(const std::vector<std::string>& block_texts, int begin, int end) {
+    std::string joined;
+    for (int i = begin; i < end; ++i) {
+        if (i > begin) {
+            joined += " ";
+        }
+        joined += block_texts[i];
+    }
+    return joined;
+}
+
+int CountSyllables(const std::string& text) {
+    // 한글은 음절 하나가 UTF-8 문자 하나이므로 공백을 뺀 코드 포인트 수를 센다
+    int count = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80 && !std::isspace(c)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void BuildSentenceTokens(Wav2VecCTCOnnxCore& engine, SentencePlan& plan) {
+    // 문장 전체 토큰: 블록 토큰 사이에 구분자 '|'
+    const int num_blocks = static_cast<int>(plan.blocks.size());
+    std::vector<int> sentence_ids;
+    int separator_id = engine.SeparatorId();
+    plan.block_token_spans.reserve(num_blocks);
+    for (int block_id = 0; block_id < num_blocks; ++block_id) {
+        if (block_id > 0) {
+            sentence_ids.push_back(separator_id);
+            plan.token_blocks.push_back(-1);
+        }
+        
+        const std::vector<int>& ids = plan.blocks[block_id].target_tokens.ids;
+        size_t first = sentence_ids.size();
+        sentence_ids.insert(sentence_ids.end(), ids.begin(), ids.end());
+        plan.token_blocks.insert(plan.token_blocks.end(), ids.size(), block_id);
+        plan.block_token_spans.emplace_back(first, sentence_ids.size());
+    }
+    plan.sentence_tokens = engine.CompileTokenIds(sentence_ids);
+    
+    plan.block_syllables.clear();
+    plan.block_syllables.reserve(plan.block_texts.size());
+    for (const auto& text : plan.block_texts) {
+        plan.block_syllables.push_back(CountSyllables(text));
+    }
+}
+
+} // namespace
+
+size_t TokenSequence::MemoryBytes() const {
+    size_t bytes = sizeof(TokenSequence) + ids.capacity() * sizeof(int) +
+                   strings.capacity() * sizeof(std::string) + words.capacity() * sizeof(Word);
+    for (const auto& str : strings) {
+        bytes += str.capacity();
+    }
+    for (const auto& word : words) {
+        bytes += word.text.capacity();
+    }
+    return bytes;
+}
+
+size_t SentencePlan::MemoryBytes() const {
+    size_t bytes = sizeof(SentencePlan) + sentence_tokens.MemoryBytes() +
+                   block_token_spans.capacity() * sizeof(std::pair<size_t, size_t>) +
+                   token_blocks.capacity() * sizeof(int) + block_syllables.capacity() * sizeof(int);
+    for (const auto& text : block_texts) {
+        bytes += sizeof(std::string) + text.capacity();
+    }
+    for (const auto& block : blocks) {
+        bytes += sizeof(BlockPlan) + block.context_tokens.MemoryBytes() + block.target_tokens.MemoryBytes();
+    }
+    return bytes;
+}
+
+std::shared_ptr<const SentencePlan> SentencePlan::Compile(
+    Wav2VecCTCOnnxCore& engine,
+    const std::vector<std::string>& block_texts) {
+    
+    auto plan = std::make_shared<SentencePlan>();
+    plan->block_texts = block_texts;
+    plan->blocks.resize(block_texts.size());
+    
+    const int num_blocks = static_cast<int>(block_texts.size());
+    for (int block_id = 0; block_id < num_blocks; ++block_id) {
+        BlockPlan& block = plan->blocks[block_id];
+        
+        // 앞뒤 최대 kContextBlocks개 블록을 컨텍스트로 (EvaluationController의 기존 규칙)
+        std::string context_before = JoinBlocks(block_texts, std::max(0, block_id - kContextBlocks), block_id);
+        std::string context_after = JoinBlocks(
+            block_texts, block_id + 1, std::min(block_id + 1 + kContextBlocks, num_blocks));
+        
+        const std::string& target_text = block_texts[block_id];
+        std::string full_text = (context_before.empty() ? "" : context_before + " ") +
+                                target_text +
+                                (context_after.empty() ? "" : " " + context_after);
+        
+        block.context_tokens = engine.CompileTokens(full_text.empty() ? target_text : full_text);
+        block.target_tokens = engine.CompileTokens(target_text);
+        block.target_word_index = CountWords(context_before);
+        block.target_word_count = CountWords(target_text);
+    }
+    
+    BuildSentenceTokens(engine, *plan);
+    
+    if (LogEnabled(LogLevel::DEBUG)) {
+        std::stringstream ss;
+        ss << "문장 계획 컴파일: " << num_blocks << " 블록, " << plan->sentence_tokens.ids.size() << " 토큰";
+        LOG_DEBUG("SentencePlan", ss.str());
+    }
+    
+    return plan;
+}
+
+std::shared_ptr<const SentencePlan> SentencePlan::FromTokenIds(
+    Wav2VecCTCOnnxCore& engine,
+    const std::vector<std::string>& block_texts,
+    const std::vector<std::vector<int>>& context_ids,
+    const std::vector<std::vector<int>>& target_ids,
+    const std::vector<std::pair<int, int>>& target_words) {
+    
+    if (context_ids.size() != block_texts.size() || target_ids.size() != block_texts.size() ||
+        target_words.size() != block_texts.size()) {
+        throw std::invalid_argument("블록 수와 토큰 목록 수가 일치하지 않습니다");
+    }
+    
+    auto plan = std::make_shared<SentencePlan>();
+    plan->block_texts = block_texts;
+    plan->blocks.resize(block_texts.size());
+    for (size_t block_id = 0; block_id < block_texts.size(); ++block_id) {
+        BlockPlan& block = plan->blocks[block_id];
+        block.context_tokens = engine.CompileTokenIds(context_ids[block_id]);
+        block.target_tokens = engine.CompileTokenIds(target_ids[block_id]);
+        block.target_word_index = target_words[block_id].first;
+        block.target_word_count = target_words[block_id].second;
+    }
+    
+    BuildSentenceTokens(engine, *plan);
+    return plan;
+}
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,244 @@
+// src/cpp/src/stage_metrics.cpp
+#include "realtime_engine_ko/stage_metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+namespace realtime_engine_ko {
+
+namespace {
+
+constexpr const char* kStageNames[kNumStages] = {
+    "ingest", "preprocess", "inference", "softmax", "align", "score", "serialize", "chunk"
+};
+
+// Prometheus 버킷 경계: 2^10-1ns(약 1us)부터 4배씩 2^34-1ns(약 17초)까지.
+// 2^m-1ns는 하위 버킷 상한이라 le(이하) 누적값이 정확하다
+constexpr int kPrometheusFirstMagnitude = 10;
+constexpr int kPrometheusLastMagnitude = 34;
+constexpr int kPrometheusStep = 2;
+
+thread_local StageMetrics* current_metrics = nullptr;
+
+int Magnitude(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+// Prometheus 레이블 값 이스케이프 (역슬래시, 큰따옴표, 줄바꿈)
+void AppendLabelValue(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default:   out += c; break;
+        }
+    }
+}
+
+} // namespace
+
+const char* StageName(Stage stage) {
+    size_t index = static_cast<size_t>(stage);
+    return index < kNumStages ? kStageNames[index] : "unknown";
+}
+
+// LatencyHistogram 구현
+LatencyHistogram::LatencyHistogram() : sum_ns(0), max_ns(0) {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t nanoseconds) {
+    if (nanoseconds < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<size_t>(nanoseconds);
+    }
+    int magnitude = Magnitude(nanoseconds);
+    if (magnitude > kMaxMagnitude) {
+        return kNumBuckets - 1;
+    }
+    // 최상위 비트 다음 kSubBucketBits 비트가 하위 버킷
+    size_t sub = static_cast<size_t>(nanoseconds >> (magnitude - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets + static_cast<size_t>(magnitude - kSubBucketBits) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < static_cast<size_t>(kSubBuckets)) {
+        return index;
+    }
+    size_t offset = index - kSubBuckets;
+    int shift = static_cast<int>(offset / kSubBuckets);
+    uint64_t mantissa = kSubBuckets + offset % kSubBuckets;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds) {
+    buckets[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t current = max_ns.load(std::memory_order_relaxed);
+    while (nanoseconds > current &&
+           !max_ns.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const {
+    // 기록과 동시에 읽으면 버킷/합계가 몇 건 어긋날 수 있다 (count는 버킷 합이라 누적값과는 항상 일치)
+    Snapshot snapshot;
+    snapshot.buckets.resize(kNumBuckets);
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum_ns = sum_ns.load(std::memory_order_relaxed);
+    snapshot.max_ns = max_ns.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sum_ns.store(0, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::Snapshot::MeanSeconds() const {
+    return count > 0 ? static_cast<double>(sum_ns) / count * 1e-9 : 0.0;
+}
+
+double LatencyHistogram::Snapshot::PercentileSeconds(double q) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return static_cast<double>(std::min(BucketUpperBound(i), max_ns)) * 1e-9;
+        }
+    }
+    return static_cast<double>(max_ns) * 1e-9;
+}
+
+uint64_t LatencyHistogram::Snapshot::CountAtMost(uint64_t value_ns) const {
+    uint64_t at_most = 0;
+    for (size_t i = 0; i < buckets.size() && BucketUpperBound(i) <= value_ns; ++i) {
+        at_most += buckets[i];
+    }
+    return at_most;
+}
+
+// StageMetrics 구현
+StageMetrics::Scope::Scope(StageMetrics* metrics) : previous(current_metrics) {
+    current_metrics = metrics;
+}
+
+StageMetrics::Scope::~Scope() {
+    current_metrics = previous;
+}
+
+StageMetrics::StageMetrics() : StageMetrics(&Global()) {
+}
+
+StageMetrics::StageMetrics(StageMetrics* parent) : parent(parent) {
+}
+
+StageMetrics& StageMetrics::Global() {
+    static StageMetrics global(nullptr);
+    return global;
+}
+
+StageMetrics& StageMetrics::Current() {
+    return current_metrics ? *current_metrics : Global();
+}
+
+void StageMetrics::Record(Stage stage, uint64_t nanoseconds) {
+    size_t index = static_cast<size_t>(stage);
+    if (index >= kNumStages) {
+        return;
+    }
+    stages[index].Record(nanoseconds);
+    if (parent) {
+        parent->Record(stage, nanoseconds);
+    }
+}
+
+StageMetrics::Snapshot StageMetrics::GetSnapshot() const {
+    Snapshot snapshot;
+    for (size_t i = 0; i < kNumStages; ++i) {
+        snapshot.stages[i] = stages[i].GetSnapshot();
+    }
+    return snapshot;
+}
+
+void StageMetrics::Reset() {
+    for (auto& histogram : stages) {
+        histogram.Reset();
+    }
+}
+
+// 직렬화
+std::string MetricsToJson(const StageMetrics::Snapshot& snapshot) {
+    nlohmann::json stages = nlohmann::json::object();
+    for (size_t i = 0; i < kNumStages; ++i) {
+        const auto& histogram = snapshot.stages[i];
+        stages[kStageNames[i]] = {
+            {"count", histogram.count},
+            {"sum_ms", static_cast<double>(histogram.sum_ns) * 1e-6},
+            {"mean_ms", histogram.MeanSeconds() * 1e3},
+            {"p50_ms", histogram.PercentileSeconds(0.50) * 1e3},
+            {"p90_ms", histogram.PercentileSeconds(0.90) * 1e3},
+            {"p99_ms", histogram.PercentileSeconds(0.99) * 1e3},
+            {"max_ms", static_cast<double>(histogram.max_ns) * 1e-6}
+        };
+    }
+    nlohmann::json json;
+    json["stages"] = std::move(stages);
+    return json.dump();
+}
+
+std::string MetricsToPrometheus(const StageMetrics::Snapshot& snapshot, const std::string& scope,
+                                const std::string& session) {
+    // 모든 줄에 공통인 레이블 앞부분 (scope, session)
+    std::string common = "scope=\"";
+    AppendLabelValue(common, scope);
+    common += '"';
+    if (!session.empty()) {
+        common += ",session=\"";
+        AppendLabelValue(common, session);
+        common += '"';
+    }
+
+    std::string out;
+    out += "# HELP realtime_engine_stage_seconds Latency of chunk pipeline stages.\n";
+    out += "# TYPE realtime_engine_stage_seconds histogram\n";
+
+    char value[64];
+    for (size_t i = 0; i < kNumStages; ++i) {
+        const auto& histogram = snapshot.stages[i];
+        std::string labels = common + ",stage=\"" + kStageNames[i] + "\"";
+
+        for (int magnitude = kPrometheusFirstMagnitude; magnitude <= kPrometheusLastMagnitude;
+             magnitude += kPrometheusStep) {
+            uint64_t bound_ns = (uint64_t(1) << magnitude) - 1;
+            std::snprintf(value, sizeof(value), ",le=\"%.9f\"} %llu\n", static_cast<double>(bound_ns) * 1e-9,
+                          static_cast<unsigned long long>(histogram.CountAtMost(bound_ns)));
+            out += "realtime_engine_stage_seconds_bucket{" + labels + value;
+        }
+        std::snprintf(value, sizeof(value), ",le=\"+Inf\"} %llu\n", static_cast<unsigned long long>(histogram.count));
+        out += "realtime_engine_stage_seconds_bucket{" + labels + value;
+        std::snprintf(value, sizeof(value), "} %.9f\n", static_cast<double>(histogram.sum_ns) * 1e-9);
+        out += "realtime_engine_stage_seconds_sum{" + labels + value;
+        std::snprintf(value, sizeof(value), "} %llu\n", static_cast<unsigned long long>(histogram.count));
+        out += "realtime_engine_stage_seconds_count{" + labels + value;
+    }
+    return out;
+}
+
+} // namespace realtime_engine_ko
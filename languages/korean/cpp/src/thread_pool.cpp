@@ -0,0 +1,50 @@
+// src/cpp/src/thread_pool.cpp
+#include "realtime_engine_ko/thread_pool.h"
+#include "realtime_engine_ko/common.h"
+#include <algorithm>
+
+namespace realtime_engine_ko {
+
+ThreadPool::ThreadPool(size_t num_threads) : stopping(false) {
+    num_threads = std::max<size_t>(1, num_threads);
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+    LOG_INFO("ThreadPool", "ThreadPool 초기화: " + std::to_string(num_threads) + " 스레드");
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            // 종료 시에도 남은 작업은 모두 처리한다
+            if (stopping && tasks.empty()) {
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+} // namespace realtime_engine_ko
@@ -0,0 +1,127 @@
+// src/cpp/src/voice_activity_detector.cpp
+#include "realtime_engine_ko/voice_activity_detector.h"
+#include "realtime_engine_ko/common.h"
+#include <sstream>
+#include <algorithm>
+
+namespace realtime_engine_ko {
+
+VoiceActivityDetector::VoiceActivityDetector(
+    int sample_rate,
+    float frame_duration,
+    float energy_threshold,
+    float max_zero_crossing_rate,
+    int min_speech_frames,
+    int onset_frames,
+    int hangover_frames)
+    : frame_size(std::max(2, static_cast<int>(sample_rate * frame_duration))),
+      energy_threshold(energy_threshold),
+      max_zero_crossing_rate(max_zero_crossing_rate),
+      min_speech_frames(min_speech_frames),
+      onset_frames(std::max(1, onset_frames)),
+      hangover_frames(hangover_frames),
+      consecutive_speech(0),
+      hangover_remaining(0) {
+    pending_samples.reserve(frame_size);
+}
+
+void VoiceActivityDetector::ComputeFrameFeatures(
+    const float* samples, size_t num_samples,
+    Eigen::VectorXf& energies, Eigen::VectorXf& zero_crossing_rates) const {
+
+    const Eigen::Index num_frames = static_cast<Eigen::Index>(num_samples / frame_size);
+    energies.resize(num_frames);
+    zero_crossing_rates.resize(num_frames);
+    if (num_frames == 0) {
+        return;
+    }
+
+    // 복사 없이 [frame_size x num_frames] 행렬로 보고 프레임(열) 단위로 한 번만 훑는다
+    Eigen::Map<const Eigen::MatrixXf> frames(samples, frame_size, num_frames);
+    const float inv_frame = 1.0f / static_cast<float>(frame_size);
+    const float inv_pairs = 1.0f / static_cast<float>(frame_size - 1);
+
+    for (Eigen::Index i = 0; i < num_frames; ++i) {
+        auto frame = frames.col(i).array();
+        energies(i) = frame.square().sum() * inv_frame;
+        zero_crossing_rates(i) = static_cast<float>(
+            ((frame.head(frame_size - 1) * frame.tail(frame_size - 1)) < 0.0f).count()) * inv_pairs;
+    }
+}
+
+bool VoiceActivityDetector::ClassifyFrame(float energy, float zero_crossing_rate) {
+    // 영교차율이 높은 저에너지 프레임은 잡음으로 간주 (충분히 큰 마찰음은 통과)
+    bool is_speech = energy > energy_threshold &&
+        (zero_crossing_rate <= max_zero_crossing_rate || energy > 4.0f * energy_threshold);
+
+    if (is_speech) {
+        consecutive_speech++;
+        // 연속 음성 프레임이 onset_frames 이상일 때만 hangover 활성화 (클릭 잡음 방지)
+        if (consecutive_speech >= onset_frames) {
+            hangover_remaining = hangover_frames;
+        }
+        return true;
+    }
+
+    consecutive_speech = 0;
+    if (hangover_remaining > 0) {
+        hangover_remaining--;
+        return true;
+    }
+    return false;
+}
+
+bool VoiceActivityDetector::ProcessChunk(const float* samples, size_t num_samples) {
+    int speech_frames = 0;
+    int total_frames = 0;
+    size_t offset = 0;
+
+    Eigen::VectorXf energies;
+    Eigen::VectorXf zero_crossing_rates;
+
+    // 이전 청크에서 남은 불완전 프레임을 먼저 채운다
+    if (!pending_samples.empty()) {
+        size_t take = std::min(static_cast<size_t>(frame_size) - pending_samples.size(), num_samples);
+        pending_samples.insert(pending_samples.end(), samples, samples + take);
+        offset = take;
+
+        if (static_cast<int>(pending_samples.size()) == frame_size) {
+            ComputeFrameFeatures(pending_samples.data(), pending_samples.size(), energies, zero_crossing_rates);
+            speech_frames += ClassifyFrame(energies(0), zero_crossing_rates(0)) ? 1 : 0;
+            total_frames++;
+            pending_samples.clear();
+        }
+    }
+
+    // 정렬된 나머지 프레임은 원본 버퍼에서 바로 처리
+    size_t remaining = num_samples - offset;
+    size_t aligned = remaining - remaining % frame_size;
+    ComputeFrameFeatures(samples + offset, aligned, energies, zero_crossing_rates);
+
+    float energy_sum = 0.0f;
+    for (Eigen::Index i = 0; i < energies.size(); ++i) {
+        speech_frames += ClassifyFrame(energies(i), zero_crossing_rates(i)) ? 1 : 0;
+        energy_sum += energies(i);
+    }
+    total_frames += static_cast<int>(energies.size());
+
+    // 다음 청크를 위해 불완전 프레임 보관
+    pending_samples.insert(pending_samples.end(), samples + offset + aligned, samples + num_samples);
+
+    if (LogEnabled(LogLevel::DEBUG)) {
+        std::stringstream ss;
+        ss << "VAD: 평균 에너지=" << (energies.size() > 0 ? energy_sum / energies.size() : 0.0f)
+           << ", 음성 프레임=" << speech_frames << "/" << total_frames;
+        LOG_DEBUG("VoiceActivityDetector", ss.str());
+    }
+
+    return speech_frames >= min_speech_frames;
+}
+
+void VoiceActivityDetector::Reset() {
+    consecutive_speech = 0;
+    hangover_remaining = 0;
+    pending_samples.clear();
+}
+
+} // namespace realtime_engine_ko
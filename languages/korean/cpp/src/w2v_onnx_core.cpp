@@ -1,6 +1,7 @@
 // src/cpp/src/w2v_onnx_core.cpp
 #include "realtime_engine_ko/w2v_onnx_core.h"
 #include "realtime_engine_ko/common.h"
+#include "realtime_engine_ko/stage_metrics.h"
 #include "dtw/dtw_algorithm.h"
 #include <sstream>
 #include <fstream>
@@ -8,6 +9,11 @@
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <iomanip>
+#include <cstdint>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
 #include <tokenizers_cpp.h>  // tokenizers-cpp 헤더 추가
 
 namespace realtime_engine_ko {
@@ -27,15 +33,15 @@ Wav2VecCTCOnnxCore::Wav2VecCTCOnnxCore(
             session_options.SetExecutionMode(ORT_SEQUENTIAL);
             
             // CPU 프로바이더 사용
-            Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "Wav2VecCTCOnnxCore");
-            session = std::make_unique<Ort::Session>(env, onnx_model_path.c_str(), session_options);
+            env = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "Wav2VecCTCOnnxCore");
+            session = std::make_unique<Ort::Session>(*env, onnx_model_path.c_str(), session_options);
         } else {
             // CUDA 프로바이더 사용
             Ort::SessionOptions cuda_options;
             cuda_options.AppendExecutionProvider_CUDA(OrtCUDAProviderOptions{});
             
-            Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "Wav2VecCTCOnnxCore");
-            session = std::make_unique<Ort::Session>(env, onnx_model_path.c_str(), cuda_options);
+            env = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "Wav2VecCTCOnnxCore");
+            session = std::make_unique<Ort::Session>(*env, onnx_model_path.c_str(), cuda_options);
         }
         
         // 2) 토크나이저 로드 - tokenizers-cpp 사용
@@ -111,6 +117,33 @@ Wav2VecCTCOnnxCore::Wav2VecCTCOnnxCore(
         // 여기서는 간단히 랜덤 행렬로 초기화
         prototype_matrix = MatrixXf::Random(vocab_size, hidden_dim);
         
+        // 6) 모델 버전: 토크나이저 내용 + ONNX 파일 식별 정보(실제 경로, 크기, 수정 시각)의 FNV-1a 해시
+        //    (컴파일된 문장 계획 캐시 키 - 같은 파일이면 프로세스/엔진이 달라도 같고, 모델을 교체하면 바뀐다)
+        uint64_t hash = 1469598103934665603ULL;
+        auto mix = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+        mix(tokenizer_content.data(), tokenizer_content.size());
+        
+        char resolved[PATH_MAX];
+        std::string model_identity = ::realpath(onnx_model_path.c_str(), resolved) ? resolved : onnx_model_path;
+        mix(model_identity.data(), model_identity.size());
+        struct stat model_stat {};
+        if (::stat(onnx_model_path.c_str(), &model_stat) == 0) {
+            int64_t stamp[3] = {static_cast<int64_t>(model_stat.st_size),
+                                static_cast<int64_t>(model_stat.st_mtim.tv_sec),
+                                static_cast<int64_t>(model_stat.st_mtim.tv_nsec)};
+            mix(stamp, sizeof(stamp));
+        }
+        
+        std::stringstream version;
+        version << std::hex << std::setw(16) << std::setfill('0') << hash;
+        model_version = version.str();
+        
         LOG_INFO("Wav2VecCTCOnnxCore", "Wav2VecCTCOnnxCore 초기화 완료");
     } catch (const Ort::Exception& e) {
         std::string error_msg = "ONNX 초기화 오류: " + std::string(e.what());
@@ -123,29 +156,25 @@ Wav2VecCTCOnnxCore::Wav2VecCTCOnnxCore(
     }
 }
 
-std::pair<std::vector<int>, std::vector<int>> Wav2VecCTCOnnxCore::DtwAlign(const MatrixXf& X, const MatrixXf& Y) {
-    // Eigen 행렬을 표준 벡터로 변환
-    std::vector<dtw::VecD> x_vecs;
-    std::vector<dtw::VecD> y_vecs;
-    
-    for (int i = 0; i < X.rows(); ++i) {
-        dtw::VecD row;
-        for (int j = 0; j < X.cols(); ++j) {
-            row.push_back(static_cast<double>(X(i, j)));
-        }
-        x_vecs.push_back(row);
-    }
+std::pair<std::vector<int>, std::vector<int>> Wav2VecCTCOnnxCore::DtwAlign(
+    const MatrixXf& X, const MatrixXf& Y, bool open_end) {
+    
+    // 유클리드 거리 행렬을 GEMM으로 한 번에 계산: |x|^2 + |y|^2 - 2 x·y
+    Eigen::MatrixXd Xd = X.cast<double>();
+    Eigen::MatrixXd Yd = Y.cast<double>();
+    Eigen::MatrixXd dist = (-2.0 * Xd * Yd.transpose()).colwise() + Xd.rowwise().squaredNorm();
+    dist.rowwise() += Yd.rowwise().squaredNorm().transpose();
+    dist = dist.cwiseMax(0.0).cwiseSqrt();
     
-    for (int i = 0; i < Y.rows(); ++i) {
-        dtw::VecD row;
-        for (int j = 0; j < Y.cols(); ++j) {
-            row.push_back(static_cast<double>(Y(i, j)));
+    dtw::MatD cost(dist.rows(), dtw::VecD(dist.cols()));
+    for (Eigen::Index i = 0; i < dist.rows(); ++i) {
+        for (Eigen::Index j = 0; j < dist.cols(); ++j) {
+            cost[i][j] = dist(i, j);
         }
-        y_vecs.push_back(row);
     }
     
     // DTW 알고리즘 호출
-    return dtw::dtw_align(x_vecs, y_vecs);
+    return dtw::dtw_align_cost(cost, open_end);
 }
 
 std::string Wav2VecCTCOnnxCore::Transcribe(const std::string& audio_path, const std::vector<int>& raw_ids) {
@@ -156,6 +185,8 @@ std::string Wav2VecCTCOnnxCore::Transcribe(const std::string& audio_path, const
     std::string pad_token = "[PAD]";
     std::string unk_token = "[UNK]";
     
+    std::lock_guard<std::mutex> lock(tokenizer_mutex);
+    
     // ID 조회 - tokenizers-cpp API 사용
     int blank_id = tokenizer->TokenToId(blank_token);
     int pad_id = tokenizer->TokenToId(pad_token);
@@ -182,12 +213,14 @@ std::string Wav2VecCTCOnnxCore::Transcribe(const std::string& audio_path, const
         prev = idx;
     }
     
-    std::stringstream ss;
-    ss << "CTC‑decoded IDs: ";
-    for (int id : dedup_ids) {
-        ss << id << " ";
+    if (LogEnabled(LogLevel::DEBUG)) {
+        std::stringstream ss;
+        ss << "CTC‑decoded IDs: ";
+        for (int id : dedup_ids) {
+            ss << id << " ";
+        }
+        LOG_DEBUG("Wav2VecCTCOnnxCore", ss.str());
     }
-    LOG_DEBUG("Wav2VecCTCOnnxCore", ss.str());
     
     // 최종 디코딩 - tokenizers-cpp API 사용
     std::string text = tokenizer->Decode(dedup_ids);
@@ -221,10 +254,11 @@ float Wav2VecCTCOnnxCore::WeightedAvgWithSigmoid(
     return std::min(raw_score, 100.0f);
 }
 
-std::vector<std::map<std::string, std::any>> Wav2VecCTCOnnxCore::GroupWordsSigmoid(
+std::vector<WordScore> Wav2VecCTCOnnxCore::GroupWordsSigmoid(
     const std::vector<std::pair<std::string, float>>& syllable_scores) {
     
-    std::vector<std::map<std::string, std::any>> words;
+    // 단어 점수는 정수로 반올림 (pronunciation은 정수 값을 갖는 float)
+    std::vector<WordScore> words;
     std::vector<std::pair<std::string, float>> current_word;
     
     for (size_t i = 0; i < syllable_scores.size(); ++i) {
@@ -240,14 +274,7 @@ std::vector<std::map<std::string, std::any>> Wav2VecCTCOnnxCore::GroupWordsSigmo
                 float word_score = std::round(
                     WeightedAvgWithSigmoid(current_word, weight_norm_mid, weight_norm_steepness));
                 
-                std::map<std::string, std::any> word_map;
-                word_map["word"] = word_text;
-                
-                std::map<std::string, std::any> scores_map;
-                scores_map["pronunciation"] = static_cast<int>(word_score);
-                word_map["scores"] = scores_map;
-                
-                words.push_back(word_map);
+                words.push_back({std::move(word_text), word_score});
                 current_word.clear();
             }
         } else {
@@ -265,39 +292,32 @@ std::vector<std::map<std::string, std::any>> Wav2VecCTCOnnxCore::GroupWordsSigmo
         float word_score = std::round(
             WeightedAvgWithSigmoid(current_word, weight_norm_mid, weight_norm_steepness));
         
-        std::map<std::string, std::any> word_map;
-        word_map["word"] = word_text;
-        
-        std::map<std::string, std::any> scores_map;
-        scores_map["pronunciation"] = static_cast<int>(word_score);
-        word_map["scores"] = scores_map;
-        
-        words.push_back(word_map);
+        words.push_back({std::move(word_text), word_score});
     }
     
     return words;
 }
 
-std::map<std::string, std::any> Wav2VecCTCOnnxCore::CalculateGopFromTensor(
-    const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor,
-    const std::string& text,
-    float eps) {
+Wav2VecCTCOnnxCore::EncoderOutput Wav2VecCTCOnnxCore::RunEncoder(
+    const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor) {
     
-    try {
-        // 입력 텐서 준비 (배치 차원 추가)
-        std::vector<int64_t> input_shape = {1, static_cast<int64_t>(audio_tensor.size())};
-        std::vector<float> input_data(audio_tensor.data(), audio_tensor.data() + audio_tensor.size());
-        
-        Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-        Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
-            memory_info, input_data.data(), input_data.size(), input_shape.data(), input_shape.size());
-        
-        // 입출력 이름 설정
-        std::vector<const char*> input_names = {input_name.c_str()};
-        std::vector<const char*> output_names = {hidden_name.c_str(), logits_name.c_str()};
-        
-        // 모델 실행
-        auto output_tensors = session->Run(
+    // 입력 텐서 준비 (배치 차원 추가)
+    std::vector<int64_t> input_shape = {1, static_cast<int64_t>(audio_tensor.size())};
+    std::vector<float> input_data(audio_tensor.data(), audio_tensor.data() + audio_tensor.size());
+    
+    Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+        memory_info, input_data.data(), input_data.size(), input_shape.data(), input_shape.size());
+    
+    // 입출력 이름 설정
+    std::vector<const char*> input_names = {input_name.c_str()};
+    std::vector<const char*> output_names = {hidden_name.c_str(), logits_name.c_str()};
+    
+    // 모델 실행 (Ort::Session::Run은 여러 스레드에서 동시에 호출 가능)
+    std::vector<Ort::Value> output_tensors;
+    {
+        ScopedStageTimer timer(Stage::INFERENCE);
+        output_tensors = session->Run(
             Ort::RunOptions{nullptr}, 
             input_names.data(), 
             &input_tensor, 
@@ -305,187 +325,446 @@ std::map<std::string, std::any> Wav2VecCTCOnnxCore::CalculateGopFromTensor(
             output_names.data(), 
             output_names.size()
         );
-        
-        if (output_tensors.size() != 2) {
-            LOG_ERROR("Wav2VecCTCOnnxCore", "ONNX 모델 실행 결과가 예상과 다릅니다.");
-            throw std::runtime_error("ONNX 모델 실행 결과가 예상과 다릅니다.");
-        }
-        
-        // 출력 텐서 정보
-        auto* hidden_data = output_tensors[0].GetTensorData<float>();
-        auto* logits_data = output_tensors[1].GetTensorData<float>();
-        
-        auto hidden_info = output_tensors[0].GetTensorTypeAndShapeInfo();
-        auto logits_info = output_tensors[1].GetTensorTypeAndShapeInfo();
-        
-        auto hidden_shape = hidden_info.GetShape();
-        auto logits_shape = logits_info.GetShape();
-        
-        // 배치 차원 제거
-        int T = hidden_shape[1];  // 시퀀스 길이
-        int D = hidden_shape[2];  // 히든 차원
-        int V = logits_shape[2];  // 어휘 크기
-        
-        // hidden 및 logits를 Eigen 행렬로 변환
-        MatrixXf X(T, D);
-        for (int t = 0; t < T; ++t) {
-            for (int d = 0; d < D; ++d) {
-                X(t, d) = hidden_data[t * D + d];
-            }
-        }
-        
-        MatrixXf logits(T, V);
-        for (int t = 0; t < T; ++t) {
-            for (int v = 0; v < V; ++v) {
-                logits(t, v) = logits_data[t * V + v];
-            }
+    }
+    ScopedStageTimer timer(Stage::SOFTMAX);
+    
+    if (output_tensors.size() != 2) {
+        LOG_ERROR("Wav2VecCTCOnnxCore", "ONNX 모델 실행 결과가 예상과 다릅니다.");
+        throw std::runtime_error("ONNX 모델 실행 결과가 예상과 다릅니다.");
+    }
+    
+    // 출력 텐서 정보
+    auto* hidden_data = output_tensors[0].GetTensorData<float>();
+    auto* logits_data = output_tensors[1].GetTensorData<float>();
+    
+    auto hidden_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
+    auto logits_shape = output_tensors[1].GetTensorTypeAndShapeInfo().GetShape();
+    
+    // 배치 차원 제거
+    int T = hidden_shape[1];  // 시퀀스 길이
+    int D = hidden_shape[2];  // 히든 차원
+    int V = logits_shape[2];  // 어휘 크기
+    
+    // hidden 및 logits를 Eigen 행렬로 변환 (ONNX 출력은 행 우선)
+    using RowMajorMatrixXf = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    EncoderOutput output;
+    output.hidden = Eigen::Map<const RowMajorMatrixXf>(hidden_data, T, D);
+    MatrixXf logits = Eigen::Map<const RowMajorMatrixXf>(logits_data, T, V);
+    
+    // 3) temperature‐scaled softmax → probs
+    VectorXf max_vals = logits.rowwise().maxCoeff();
+    MatrixXf exp_logits = (logits.colwise() - max_vals).array().exp();
+    VectorXf sum_exp = exp_logits.rowwise().sum();
+    output.probs = exp_logits.array().colwise() / sum_exp.array();
+    
+    return output;
+}
+
+std::vector<int> Wav2VecCTCOnnxCore::EncodeText(const std::string& text) {
+    // 공백은 단어 구분자 '|'로 치환
+    std::string processed_text = text;
+    std::replace(processed_text.begin(), processed_text.end(), ' ', '|');
+    
+    const int V = static_cast<int>(prototype_matrix.rows());
+    std::vector<int> safe_ids;
+    
+    std::lock_guard<std::mutex> lock(tokenizer_mutex);
+    std::vector<int> token_ids = tokenizer->Encode(processed_text);
+    
+    // special token 처리
+    std::string blank_token = "|";
+    int blank_id = tokenizer->TokenToId(blank_token);
+    
+    safe_ids.reserve(token_ids.size());
+    for (int tid : token_ids) {
+        if (tid >= 0 && tid < V) {
+            safe_ids.push_back(tid);
+        } else {
+            safe_ids.push_back(blank_id);
         }
-        
-        // 3) temperature‐scaled softmax → probs
-        MatrixXf scaled = logits;
-        VectorXf max_vals = scaled.rowwise().maxCoeff();
-        MatrixXf exp_logits = (scaled.colwise() - max_vals).array().exp();
-        VectorXf sum_exp = exp_logits.rowwise().sum();
-        MatrixXf probs = exp_logits.array().colwise() / sum_exp.array();
-        
-        // 4) 텍스트 토큰화 - tokenizers-cpp API 사용
-        std::string processed_text = text;
-        std::replace(processed_text.begin(), processed_text.end(), ' ', '|');
-        std::vector<int> token_ids = tokenizer->Encode(processed_text);
-        
-        // special token 처리
-        std::string blank_token = "|";
-        int blank_id = tokenizer->TokenToId(blank_token);
-        
-        std::vector<int> safe_ids;
+    }
+    
+    return safe_ids;
+}
+
+TokenSequence Wav2VecCTCOnnxCore::CompileTokens(const std::string& text) {
+    return CompileTokenIds(EncodeText(text));
+}
+
+TokenSequence Wav2VecCTCOnnxCore::CompileTokenIds(const std::vector<int>& token_ids) {
+    TokenSequence tokens;
+    tokens.ids = token_ids;
+    
+    {
+        std::lock_guard<std::mutex> lock(tokenizer_mutex);
+        tokens.strings.reserve(token_ids.size());
         for (int tid : token_ids) {
-            if (tid >= 0 && tid < V) {
-                safe_ids.push_back(tid);
-            } else {
-                safe_ids.push_back(blank_id);
-            }
+            tokens.strings.push_back(tokenizer->IdToToken(tid));
         }
-        
-        // 5) prototype 확장 및 DTW
-        MatrixXf proto(safe_ids.size(), D);
-        for (size_t i = 0; i < safe_ids.size(); ++i) {
-            proto.row(i) = prototype_matrix.row(safe_ids[i]);
+    }
+    
+    // '|'로 나뉘는 단어 범위 (GroupWordsSigmoid와 같은 규칙)
+    size_t begin = 0;
+    for (size_t i = 0; i <= tokens.strings.size(); ++i) {
+        if (i == tokens.strings.size() || tokens.strings[i] == "|") {
+            if (i > begin) {
+                TokenSequence::Word word;
+                word.begin = begin;
+                word.end = i;
+                for (size_t j = begin; j < i; ++j) {
+                    word.text += tokens.strings[j];
+                }
+                tokens.words.push_back(std::move(word));
+            }
+            begin = i + 1;
         }
-        
-        int M = safe_ids.size();
-        int avg = std::max(1, T / M);
-        
-        // Y 확장
+    }
+    
+    return tokens;
+}
+
+int Wav2VecCTCOnnxCore::SeparatorId() {
+    std::lock_guard<std::mutex> lock(tokenizer_mutex);
+    return tokenizer->TokenToId("|");
+}
+
+std::vector<std::vector<int>> Wav2VecCTCOnnxCore::AlignTokenFrames(
+    const EncoderOutput& output,
+    const int* token_ids,
+    size_t num_tokens,
+    int expected_tokens,
+    bool open_end) {
+    
+    ScopedStageTimer timer(Stage::ALIGN);
+    const bool use_hidden = output.hidden.rows() > 0;
+    const int T = static_cast<int>(use_hidden ? output.hidden.rows() : output.probs.rows());
+    const int M = static_cast<int>(num_tokens);
+    std::vector<std::vector<int>> frames(M);
+    if (T == 0 || M == 0) {
+        return frames;
+    }
+    
+    // 5) prototype 확장 및 DTW (토큰당 프레임 수만큼 반복)
+    int avg = std::max(1, T / std::max(1, expected_tokens > 0 ? expected_tokens : M));
+    
+    std::pair<std::vector<int>, std::vector<int>> path;
+    if (use_hidden) {
+        const int D = static_cast<int>(output.hidden.cols());
         MatrixXf Yexp(M * avg, D);
         for (int i = 0; i < M; ++i) {
             for (int j = 0; j < avg; ++j) {
-                Yexp.row(i * avg + j) = proto.row(i);
+                Yexp.row(i * avg + j) = prototype_matrix.row(token_ids[i]);
             }
         }
         
         // DTW 정렬
-        auto [pX, pYexp] = DtwAlign(X, Yexp);
-        
-        std::vector<int> pY;
-        for (int y : pYexp) {
-            pY.push_back(y / avg);
+        path = DtwAlign(output.hidden, Yexp, open_end);
+    } else {
+        // 히든 상태 없이 저장된 프레임 (FrameStore): 토큰 사후 확률의 -log를 거리로 쓴다
+        dtw::MatD cost(T, dtw::VecD(static_cast<size_t>(M) * avg));
+        for (int t = 0; t < T; ++t) {
+            for (int i = 0; i < M; ++i) {
+                double distance = -std::log(static_cast<double>(output.probs(t, token_ids[i])) + 1e-8);
+                std::fill_n(cost[t].begin() + static_cast<size_t>(i) * avg, avg, distance);
+            }
         }
-        
-        // 6) 토큰별 프레임 수집
-        std::map<int, std::vector<int>> frames;
-        for (size_t i = 0; i < pX.size(); ++i) {
-            frames[pY[i]].push_back(pX[i]);
+        path = dtw::dtw_align_cost(cost, open_end);
+    }
+    const auto& [pX, pYexp] = path;
+    
+    // 6) 토큰별 프레임 수집
+    for (size_t i = 0; i < pX.size(); ++i) {
+        frames[pYexp[i] / avg].push_back(pX[i]);
+    }
+    
+    return frames;
+}
+
+std::vector<float> Wav2VecCTCOnnxCore::ScoreTokenFrames(
+    const MatrixXf& probs,
+    const int* token_ids,
+    size_t num_tokens,
+    const std::vector<std::vector<int>>& frames,
+    float eps) {
+    
+    // 7) 토큰별 평균 로그 확률 (정렬된 프레임이 없으면 -inf)
+    std::vector<float> scores(num_tokens, -std::numeric_limits<float>::infinity());
+    for (size_t idx = 0; idx < num_tokens && idx < frames.size(); ++idx) {
+        const auto& frs = frames[idx];
+        if (frs.empty()) {
+            continue;
         }
         
-        // 7) 토큰별 로그 확률 점수
-        std::vector<std::pair<std::string, float>> tok_scores;
-        for (size_t idx = 0; idx < safe_ids.size(); ++idx) {
-            int tid = safe_ids[idx];
-            std::string tok = tokenizer->IdToToken(tid);
-            
-            float score;
-            const auto& frs = frames[idx];
-            
-            if (!frs.empty()) {
-                float sum_log_p = 0.0f;
-                for (int fr : frs) {
-                    sum_log_p += std::log(probs(fr, tid) + eps);
-                }
-                score = sum_log_p / frs.size();
-            } else {
-                score = -std::numeric_limits<float>::infinity();
-            }
-            
-            tok_scores.push_back({tok, score});
+        float sum_log_p = 0.0f;
+        for (int fr : frs) {
+            sum_log_p += std::log(probs(fr, token_ids[idx]) + eps);
         }
-        
-        // 8) [0,100] 범위로 정규화
-        std::vector<float> raw;
-        for (const auto& [_, s] : tok_scores) {
-            if (std::isfinite(s)) {
-                raw.push_back(s);
-            }
+        scores[idx] = sum_log_p / frs.size();
+    }
+    return scores;
+}
+
+std::vector<float> Wav2VecCTCOnnxCore::NormalizeScores(const std::vector<float>& raw_scores, float eps) {
+    // 8) 유한한 값의 최소/최대 기준으로 [0,100] 범위로 정규화
+    float mn = std::numeric_limits<float>::infinity();
+    float mx = -std::numeric_limits<float>::infinity();
+    for (float s : raw_scores) {
+        if (std::isfinite(s)) {
+            mn = std::min(mn, s);
+            mx = std::max(mx, s);
         }
-        
-        std::vector<std::pair<std::string, float>> norm;
-        if (!raw.empty()) {
-            float mn = *std::min_element(raw.begin(), raw.end());
-            float mx = *std::max_element(raw.begin(), raw.end());
-            float span = (mx > mn) ? (mx - mn) : eps;
-            
-            for (const auto& [t, s] : tok_scores) {
-                float normalized = std::isfinite(s) ? (s - mn) / span * 100.0f : 0.0f;
-                norm.push_back({t, normalized});
-            }
-        } else {
-            for (const auto& [t, _] : tok_scores) {
-                norm.push_back({t, 0.0f});
+    }
+    
+    std::vector<float> norm(raw_scores.size(), 0.0f);
+    if (!std::isfinite(mn)) {
+        return norm;
+    }
+    
+    float span = (mx > mn) ? (mx - mn) : eps;
+    for (size_t i = 0; i < raw_scores.size(); ++i) {
+        norm[i] = std::isfinite(raw_scores[i]) ? (raw_scores[i] - mn) / span * 100.0f : 0.0f;
+    }
+    return norm;
+}
+
+float Wav2VecCTCOnnxCore::WeightedAvgOfRange(const std::vector<float>& scores, size_t begin, size_t end) {
+    // WeightedAvgWithSigmoid와 같은 계산 (범위에는 구분자가 없다)
+    float total_weighted_score = 0.0f;
+    float total_weight = 0.0f;
+    for (size_t i = begin; i < end; ++i) {
+        float weight = SigmoidWeight(scores[i], weight_norm_mid, weight_norm_steepness);
+        total_weighted_score += scores[i] * weight;
+        total_weight += weight;
+    }
+    
+    float raw_score = total_weight > 0.0f ? total_weighted_score / total_weight : 0.0f;
+    return std::min(raw_score, 100.0f);
+}
+
+GopResult Wav2VecCTCOnnxCore::ScoreText(
+    const EncoderOutput& output,
+    const std::string& text,
+    float eps) {
+    
+    // 4) 텍스트 토큰화 - tokenizers-cpp API 사용
+    return ScoreTokens(output, CompileTokens(text), eps);
+}
+
+GopResult Wav2VecCTCOnnxCore::ScoreTokens(
+    const EncoderOutput& output,
+    const TokenSequence& tokens,
+    float eps) {
+    
+    // 5~7) 정렬 및 토큰별 점수
+    auto frames = AlignTokenFrames(output, tokens.ids.data(), tokens.ids.size());
+    ScopedStageTimer timer(Stage::SCORE);
+    auto raw_scores = ScoreTokenFrames(output.probs, tokens.ids.data(), tokens.ids.size(), frames, eps);
+    auto norm_scores = NormalizeScores(raw_scores, eps);
+    
+    // 9) 단어로 그룹화 (단어 범위는 컴파일 시 계산됨, 단어 점수는 정수로 반올림)
+    GopResult result;
+    result.words.reserve(tokens.words.size());
+    float overall = 0.0f;
+    for (const auto& word : tokens.words) {
+        float word_score = std::round(WeightedAvgOfRange(norm_scores, word.begin, word.end));
+        result.words.push_back({word.text, word_score});
+        overall += word_score;
+    }
+    
+    // 전체 점수 계산
+    if (!result.words.empty()) {
+        overall /= result.words.size();
+    }
+    
+    result.overall = std::round(overall * 10) / 10;  // 소수점 첫째 자리까지
+    result.pronunciation = result.overall;
+    
+    return result;
+}
+
+GopResult Wav2VecCTCOnnxCore::ScoreBlock(
+    const EncoderOutput& output,
+    const BlockPlan& block,
+    float eps) {
+    
+    // 컨텍스트를 포함한 전체 텍스트로 GOP 계산
+    auto result = ScoreTokens(output, block.context_tokens, eps);
+    
+    const int target_index = block.target_word_index;
+    if (result.words.empty() || result.words.size() <= static_cast<size_t>(target_index)) {
+        // 전체 텍스트 처리에 실패한 경우, 대상 텍스트만으로 시도
+        return ScoreTokens(output, block.target_tokens, eps);
+    }
+    
+    // 대상 블록 단어만 추출
+    int end_index = std::min(target_index + block.target_word_count, static_cast<int>(result.words.size()));
+    GopResult target_result;
+    target_result.words.reserve(std::max(0, end_index - target_index));
+    
+    float target_score = 0.0f;
+    for (int i = target_index; i < end_index; ++i) {
+        target_score += result.words[i].pronunciation;
+        target_result.words.push_back(std::move(result.words[i]));
+    }
+    if (!target_result.words.empty()) {
+        target_score /= target_result.words.size();
+    }
+    
+    target_result.overall = std::round(target_score * 10) / 10;
+    target_result.pronunciation = target_result.overall;
+    
+    return target_result;
+}
+
+float Wav2VecCTCOnnxCore::SpotTokens(
+    const EncoderOutput& output,
+    const TokenSequence& tokens,
+    float eps) const {
+    
+    ScopedStageTimer timer(Stage::SCORE);
+    
+    // probs는 열 우선이라 토큰 열 하나의 최대값은 연속 메모리 스캔이다
+    float sum_log_p = 0.0f;
+    size_t count = 0;
+    if (output.probs.rows() > 0) {
+        for (const auto& word : tokens.words) {
+            for (size_t i = word.begin; i < word.end; ++i) {
+                sum_log_p += std::log(output.probs.col(tokens.ids[i]).maxCoeff() + eps);
+                count++;
             }
         }
-        
-        // 9) 단어로 그룹화
-        auto words = GroupWordsSigmoid(norm);
-        
-        // 전체 점수 계산
-        float overall = 0.0f;
-        if (!words.empty()) {
-            for (const auto& word : words) {
-                auto scores = std::any_cast<std::map<std::string, std::any>>(word.at("scores"));
-                overall += std::any_cast<int>(scores.at("pronunciation"));
-            }
-            overall /= words.size();
+    }
+    
+    return count > 0 ? sum_log_p / count : -std::numeric_limits<float>::infinity();
+}
+
+Wav2VecCTCOnnxCore::MatrixXf Wav2VecCTCOnnxCore::TokenDistances(
+    const MatrixXf& hidden,
+    const int* token_ids,
+    size_t num_tokens) const {
+    
+    Eigen::MatrixXd prototypes(static_cast<Eigen::Index>(num_tokens), prototype_matrix.cols());
+    for (size_t k = 0; k < num_tokens; ++k) {
+        prototypes.row(static_cast<Eigen::Index>(k)) = prototype_matrix.row(token_ids[k]).cast<double>();
+    }
+    
+    // DtwAlign과 같은 GEMM 전개: |x|^2 + |y|^2 - 2 x·y
+    Eigen::MatrixXd Xd = hidden.cast<double>();
+    Eigen::MatrixXd dist = (-2.0 * Xd * prototypes.transpose()).colwise() + Xd.rowwise().squaredNorm();
+    dist.rowwise() += prototypes.rowwise().squaredNorm().transpose();
+    return dist.cwiseMax(0.0).cwiseSqrt().cast<float>();
+}
+
+GopResult Wav2VecCTCOnnxCore::ScoreAlignedTokens(
+    const TokenSequence& tokens,
+    const std::vector<float>& raw_scores,
+    size_t norm_begin, size_t norm_end,
+    size_t begin, size_t end,
+    float eps) {
+    
+    ScopedStageTimer timer(Stage::SCORE);
+    std::vector<float> norm_scores = NormalizeScores(
+        std::vector<float>(raw_scores.begin() + norm_begin, raw_scores.begin() + norm_end), eps);
+    
+    GopResult result;
+    float overall = 0.0f;
+    for (const auto& word : tokens.words) {
+        if (word.begin < begin || word.end > end) {
+            continue;
         }
-        
-        // 결과 맵 생성
-        std::map<std::string, std::any> result;
-        result["overall"] = std::round(overall * 10) / 10;  // 소수점 첫째 자리까지
-        result["pronunciation"] = std::round(overall * 10) / 10;
-        result["words"] = words;
-        
-        return result;
+        float word_score = std::round(WeightedAvgOfRange(norm_scores, word.begin - norm_begin, word.end - norm_begin));
+        result.words.push_back({word.text, word_score});
+        overall += word_score;
+    }
+    
+    if (!result.words.empty()) {
+        overall /= result.words.size();
+    }
+    
+    result.overall = std::round(overall * 10) / 10;
+    result.pronunciation = result.overall;
+    return result;
+}
+
+std::vector<Wav2VecCTCOnnxCore::SegmentBlockScore> Wav2VecCTCOnnxCore::AlignSegmentToBlocks(
+    const EncoderOutput& output,
+    const SentencePlan& plan,
+    int first_block,
+    int num_blocks,
+    int expected_blocks,
+    float eps) {
+    
+    std::vector<SegmentBlockScore> block_scores(std::max(0, num_blocks));
+    if (num_blocks <= 0 || output.hidden.rows() == 0) {
+        return block_scores;
+    }
+    
+    // 후보 블록 열의 토큰은 문장 전체 토큰의 연속 구간이다 (블록 사이 '|' 포함)
+    size_t begin = plan.block_token_spans[first_block].first;
+    size_t end = plan.block_token_spans[first_block + num_blocks - 1].second;
+    int expected_tokens = 0;
+    if (expected_blocks > 0) {
+        int last_expected = first_block + std::min(expected_blocks, num_blocks) - 1;
+        expected_tokens = static_cast<int>(plan.block_token_spans[last_expected].second - begin);
+    }
+    
+    const TokenSequence& tokens = plan.sentence_tokens;
+    
+    // open-end 정렬: 세그먼트가 후보 블록 열의 앞부분만 담고 있어도 된다
+    auto frames = AlignTokenFrames(output, tokens.ids.data() + begin, end - begin, expected_tokens, true);
+    ScopedStageTimer timer(Stage::SCORE);
+    auto raw_scores = ScoreTokenFrames(output.probs, tokens.ids.data() + begin, end - begin, frames, eps);
+    auto norm_scores = NormalizeScores(raw_scores, eps);
+    
+    // 블록별 커버리지와 시그모이드 가중 평균 점수
+    std::vector<std::vector<std::pair<std::string, float>>> block_syllables(num_blocks);
+    std::vector<int> block_tokens(num_blocks, 0);
+    std::vector<int> block_aligned(num_blocks, 0);
+    for (size_t i = 0; i < end - begin; ++i) {
+        int block_id = plan.token_blocks[begin + i];
+        if (block_id < 0) {
+            continue;
+        }
+        int b = block_id - first_block;
+        block_tokens[b]++;
+        if (!frames[i].empty()) {
+            block_aligned[b]++;
+            block_syllables[b].push_back({tokens.strings[begin + i], norm_scores[i]});
+        }
+    }
+    
+    for (int b = 0; b < num_blocks; ++b) {
+        if (block_tokens[b] > 0) {
+            block_scores[b].coverage = static_cast<float>(block_aligned[b]) / block_tokens[b];
+        }
+        block_scores[b].score = WeightedAvgWithSigmoid(block_syllables[b], weight_norm_mid, weight_norm_steepness);
+    }
+    
+    return block_scores;
+}
+
+GopResult Wav2VecCTCOnnxCore::CalculateGopFromTensor(
+    const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor,
+    const std::string& text,
+    float eps) {
+    
+    try {
+        return ScoreText(RunEncoder(audio_tensor), text, eps);
         
     } catch (const Ort::Exception& e) {
         LOG_ERROR("Wav2VecCTCOnnxCore", "ONNX 실행 오류: " + std::string(e.what()));
         
         // 오류 시 빈 결과 반환
-        std::map<std::string, std::any> result;
-        result["overall"] = 0.0f;
-        result["pronunciation"] = 0.0f;
-        result["words"] = std::vector<std::map<std::string, std::any>>();
-        return result;
+        return GopResult();
     } catch (const std::exception& e) {
         LOG_ERROR("Wav2VecCTCOnnxCore", "GOP 계산 오류: " + std::string(e.what()));
         
         // 오류 시 빈 결과 반환
-        std::map<std::string, std::any> result;
-        result["overall"] = 0.0f;
-        result["pronunciation"] = 0.0f;
-        result["words"] = std::vector<std::map<std::string, std::any>>();
-        return result;
+        return GopResult();
     }
 }
 
-std::map<std::string, std::any> Wav2VecCTCOnnxCore::CalculateGopWithContext(
+GopResult Wav2VecCTCOnnxCore::CalculateGopWithContext(
     const Eigen::Matrix<float, Eigen::Dynamic, 1>& audio_tensor,
     const std::string& target_text,
     const std::string& context_before,
@@ -527,7 +806,7 @@ std::map<std::string, std::any> Wav2VecCTCOnnxCore::CalculateGopWithContext(
     auto result = CalculateGopFromTensor(audio_tensor, full_text);
     
     // 모든 단어가 있는지 확인
-    auto words = std::any_cast<std::vector<std::map<std::string, std::any>>>(result["words"]);
+    const auto& words = result.words;
     
     if (words.empty() || words.size() <= actual_target_index) {
         // 전체 텍스트 처리에 실패한 경우, 대상 텍스트만으로 시도
@@ -537,26 +816,24 @@ std::map<std::string, std::any> Wav2VecCTCOnnxCore::CalculateGopWithContext(
     // target_index 위치의 단어들에 해당하는 결과 추출
     // 인덱스 범위 유효성 검사
     int end_index = std::min(actual_target_index + target_word_count, static_cast<int>(words.size()));
-    std::vector<std::map<std::string, std::any>> target_words;
+    GopResult target_result;
+    target_result.words.reserve(std::max(0, end_index - actual_target_index));
     
     for (int i = actual_target_index; i < end_index; ++i) {
-        target_words.push_back(words[i]);
+        target_result.words.push_back(std::move(result.words[i]));
     }
     
     // 대상 블록에 대한 결과 생성
     float target_score = 0.0f;
-    if (!target_words.empty()) {
-        for (const auto& word : target_words) {
-            auto scores = std::any_cast<std::map<std::string, std::any>>(word.at("scores"));
-            target_score += std::any_cast<int>(scores.at("pronunciation"));
+    if (!target_result.words.empty()) {
+        for (const auto& word : target_result.words) {
+            target_score += word.pronunciation;
         }
-        target_score /= target_words.size();
+        target_score /= target_result.words.size();
     }
     
-    std::map<std::string, std::any> target_result;
-    target_result["overall"] = std::round(target_score * 10) / 10;
-    target_result["pronunciation"] = std::round(target_score * 10) / 10;
-    target_result["words"] = target_words;
+    target_result.overall = std::round(target_score * 10) / 10;
+    target_result.pronunciation = target_result.overall;
     
     return target_result;
 }
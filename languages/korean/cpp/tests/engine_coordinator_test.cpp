@@ -0,0 +1,81 @@
+// tests/engine_coordinator_test.cpp
+// 비동기 평가를 취소한 코디네이터로 이어서 EvaluateFile을 돌려도 청크가 버려지지 않고 결과가 나오는지 확인한다.
+//
+// 필요한 환경 변수 (하나라도 없으면 건너뜀):
+//   REALTIME_ENGINE_KO_TEST_MODEL      ONNX 모델
+//   REALTIME_ENGINE_KO_TEST_TOKENIZER  tokenizer.json
+//   REALTIME_ENGINE_KO_TEST_AUDIO      문장을 읽은 wav
+//   REALTIME_ENGINE_KO_TEST_TEXT       문장
+#include "realtime_engine_ko/recognition_engine.h"
+#include <any>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace realtime_engine_ko;
+
+namespace {
+
+constexpr int kSkip = 77;
+constexpr auto kCancelTimeout = std::chrono::seconds(10);  // 취소는 다음 틱에 확정된다
+
+int failures = 0;
+
+void Expect(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "실패: " << message << "\n";
+        failures++;
+    }
+}
+
+const char* Env(const char* name) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : nullptr;
+}
+
+} // namespace
+
+int main() {
+    const char* model = Env("REALTIME_ENGINE_KO_TEST_MODEL");
+    const char* tokenizer = Env("REALTIME_ENGINE_KO_TEST_TOKENIZER");
+    const char* audio_path = Env("REALTIME_ENGINE_KO_TEST_AUDIO");
+    const char* text = Env("REALTIME_ENGINE_KO_TEST_TEXT");
+    if (!model || !tokenizer || !audio_path || !text) {
+        std::cerr << "건너뜀: REALTIME_ENGINE_KO_TEST_{MODEL,TOKENIZER,AUDIO,TEXT} 필요\n";
+        return kSkip;
+    }
+
+    EngineCoordinator coordinator(model, tokenizer);
+
+    // 1. 비동기 평가를 시작하자마자 취소한다
+    auto cancel = std::make_shared<CancellationToken>();
+    cancel->Cancel();
+    std::future<EngineState> future = coordinator.EvaluateSpeechAsync(text, audio_path, RecordListener(), nullptr, cancel);
+    if (future.wait_for(kCancelTimeout) != std::future_status::ready) {
+        std::cerr << "실패: 취소한 비동기 평가가 완료되지 않음\n";
+        return 1;
+    }
+    EngineState cancelled = future.get();
+    Expect(cancelled.status == "cancelled", "비동기 평가 상태 '" + cancelled.status + "' != 'cancelled'");
+    coordinator.StopEvaluation();
+
+    // 2. 같은 코디네이터로 오프라인 평가: 취소 상태가 남아 있으면 모든 청크가 버려진다
+    auto result = coordinator.EvaluateFile(text, audio_path);
+    auto status = result.find("status");
+    Expect(status != result.end() && std::any_cast<std::string>(status->second) == "completed",
+           "EvaluateFile이 완료되지 않음");
+
+    EngineState state = coordinator.GetState();
+    Expect(state.audio && state.audio->total_chunks > 0, "EvaluateFile이 청크를 처리하지 않음");
+    Expect(state.summary && state.summary->completed > 0, "취소 뒤 EvaluateFile에서 평가된 블록이 없음");
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "통과: 취소 후 EvaluateFile 평가 블록 " << state.summary->completed
+              << "/" << state.summary->total << "\n";
+    return 0;
+}
@@ -0,0 +1,118 @@
+// tests/incremental_aligner_test.cpp
+// 템플릿의 2배보다 긴 오디오(앞쪽 무음 + 문장 중간의 긴 쉼)를 청크로 나눠 넣어도
+// IncrementalAligner가 모든 블록을 순서대로 한 번씩 확정하는지 확인한다.
+//
+// 필요한 환경 변수 (하나라도 없으면 건너뜀):
+//   REALTIME_ENGINE_KO_TEST_MODEL      ONNX 모델
+//   REALTIME_ENGINE_KO_TEST_TOKENIZER  tokenizer.json
+//   REALTIME_ENGINE_KO_TEST_AUDIO      문장을 읽은 wav
+//   REALTIME_ENGINE_KO_TEST_TEXT       문장 (공백으로 블록 구분)
+#include "realtime_engine_ko/incremental_aligner.h"
+#include "realtime_engine_ko/audio_processor.h"
+#include "realtime_engine_ko/sentence_plan.h"
+#include "realtime_engine_ko/w2v_onnx_core.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace realtime_engine_ko;
+
+namespace {
+
+constexpr int kSkip = 77;
+constexpr int kSamplesPerFrame = 320;     // 인코더 프레임 간격 (16kHz에서 20ms)
+constexpr float kChunkSeconds = 2.0f;     // 스트리밍 세션의 청크 길이
+constexpr float kLeadingSilence = 1.0f;   // 초
+constexpr float kTemplateRatio = 2.5f;    // 전체 프레임 / 템플릿 프레임
+
+int failures = 0;
+
+void Expect(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "실패: " << message << "\n";
+        failures++;
+    }
+}
+
+const char* Env(const char* name) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : nullptr;
+}
+
+} // namespace
+
+int main() {
+    const char* model = Env("REALTIME_ENGINE_KO_TEST_MODEL");
+    const char* tokenizer = Env("REALTIME_ENGINE_KO_TEST_TOKENIZER");
+    const char* audio_path = Env("REALTIME_ENGINE_KO_TEST_AUDIO");
+    const char* text = Env("REALTIME_ENGINE_KO_TEST_TEXT");
+    if (!model || !tokenizer || !audio_path || !text) {
+        std::cerr << "건너뜀: REALTIME_ENGINE_KO_TEST_{MODEL,TOKENIZER,AUDIO,TEXT} 필요\n";
+        return kSkip;
+    }
+
+    auto engine = std::make_shared<Wav2VecCTCOnnxCore>(model, tokenizer);
+
+    std::vector<std::string> blocks;
+    std::istringstream words(text);
+    for (std::string word; words >> word;) {
+        blocks.push_back(word);
+    }
+    auto plan = SentencePlan::Compile(*engine, blocks);
+
+    AudioProcessor audio_processor(Wav2VecCTCOnnxCore::kSampleRate);
+    AudioProcessor::AudioTensor speech;
+    if (!audio_processor.LoadFile(audio_path, speech) || speech.size() == 0) {
+        std::cerr << "오디오를 읽을 수 없습니다: " << audio_path << "\n";
+        return 1;
+    }
+
+    // 앞쪽 무음 + 앞 절반 + 쉼 + 뒤 절반. 쉼은 전체가 템플릿의 kTemplateRatio배가 되도록 채운다
+    IncrementalAligner::Options options;
+    const long template_samples = static_cast<long>(plan->sentence_tokens.ids.size()) *
+                                  options.frames_per_token * kSamplesPerFrame;
+    const long leading = static_cast<long>(kLeadingSilence * Wav2VecCTCOnnxCore::kSampleRate);
+    const long target = static_cast<long>(kTemplateRatio * template_samples);
+    const long pause = std::max(0L, target - leading - static_cast<long>(speech.size()));
+    const long half = speech.size() / 2;
+
+    AudioProcessor::AudioTensor audio = AudioProcessor::AudioTensor::Zero(leading + speech.size() + pause);
+    audio.segment(leading, half) = speech.head(half);
+    audio.segment(leading + half + pause, speech.size() - half) = speech.tail(speech.size() - half);
+
+    IncrementalAligner aligner(engine, plan, options);
+    std::vector<IncrementalAligner::BlockScore> scores;
+    const long chunk = static_cast<long>(kChunkSeconds * Wav2VecCTCOnnxCore::kSampleRate);
+    for (long start = 0; start < audio.size(); start += chunk) {
+        long length = std::min(chunk, static_cast<long>(audio.size()) - start);
+        AudioProcessor::AudioTensor piece = audio.segment(start, length);
+        for (auto& score : aligner.Extend(engine->RunEncoder(piece))) {
+            scores.push_back(std::move(score));
+        }
+    }
+    for (auto& score : aligner.Finish()) {
+        scores.push_back(std::move(score));
+    }
+
+    const size_t template_frames = plan->sentence_tokens.ids.size() * options.frames_per_token;
+    Expect(aligner.Frames() > 2 * template_frames,
+           "오디오가 템플릿의 2배보다 길어야 함 (프레임 " + std::to_string(aligner.Frames()) +
+           ", 템플릿 " + std::to_string(template_frames) + ")");
+    Expect(scores.size() == blocks.size(),
+           "확정된 블록 수 " + std::to_string(scores.size()) + " != " + std::to_string(blocks.size()));
+    for (size_t i = 0; i < scores.size(); ++i) {
+        Expect(scores[i].block_id == static_cast<int>(i),
+               "블록 순서: " + std::to_string(i) + "번째가 " + std::to_string(scores[i].block_id));
+        Expect(scores[i].coverage > 0.0f, "블록 " + std::to_string(scores[i].block_id) + "가 정렬되지 않음");
+    }
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "통과: 블록 " << scores.size() << "개, 프레임 " << aligner.Frames()
+              << " (템플릿 " << template_frames << ")\n";
+    return 0;
+}
@@ -0,0 +1,202 @@
+// tools/gop_batch.cpp
+// 매니페스트의 (오디오, 문장) 쌍을 하나의 모델을 공유하는 스레드 풀에서 오프라인 평가한다.
+//
+// 매니페스트 형식 (한 줄에 하나, 탭 구분, '#'으로 시작하면 주석):
+//   <wav 경로>\t<문장>
+//
+// 출력: 입력 순서대로 한 줄에 하나의 JSON 객체 (JSON Lines)
+#include "realtime_engine_ko/recognition_engine.h"
+#include "realtime_engine_ko/thread_pool.h"
+#include "realtime_engine_ko/common.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <future>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace realtime_engine_ko;
+
+namespace {
+
+struct BatchItem {
+    std::string audio_path;
+    std::string sentence;
+};
+
+void PrintUsage(const char* program) {
+    std::cerr << "사용법: " << program << " --model <onnx> --tokenizer <tokenizer.json> --manifest <tsv>\n"
+              << "        [--threads N] [--output <jsonl>] [--whole-file | --long-form] [--device CPU]\n"
+              << "        [--confidence-threshold T]\n";
+}
+
+bool LoadManifest(const std::string& path, std::vector<BatchItem>& items) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "매니페스트를 열 수 없습니다: " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || tab == 0 || tab + 1 >= line.size()) {
+            std::cerr << "매니페스트 " << line_number << "번째 줄 형식 오류 (wav\\t문장 필요)\n";
+            return false;
+        }
+        items.push_back({line.substr(0, tab), line.substr(tab + 1)});
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string model_path;
+    std::string tokenizer_path;
+    std::string manifest_path;
+    std::string output_path;
+    std::string device = "CPU";
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    float confidence_threshold = 0.7f;
+    bool chunked = true;
+    bool long_form = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](std::string& value) {
+            if (i + 1 >= argc) {
+                PrintUsage(argv[0]);
+                std::exit(2);
+            }
+            value = argv[++i];
+        };
+
+        std::string value;
+        try {
+            if (arg == "--model") {
+                next(model_path);
+            } else if (arg == "--tokenizer") {
+                next(tokenizer_path);
+            } else if (arg == "--manifest") {
+                next(manifest_path);
+            } else if (arg == "--output") {
+                next(output_path);
+            } else if (arg == "--device") {
+                next(device);
+            } else if (arg == "--threads") {
+                next(value);
+                num_threads = std::max(1, std::stoi(value));
+            } else if (arg == "--confidence-threshold") {
+                next(value);
+                confidence_threshold = std::stof(value);
+            } else if (arg == "--whole-file") {
+                chunked = false;
+            } else if (arg == "--long-form") {
+                long_form = true;
+            } else if (arg == "--help" || arg == "-h") {
+                PrintUsage(argv[0]);
+                return 0;
+            } else {
+                std::cerr << "알 수 없는 옵션: " << arg << "\n";
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        } catch (const std::exception&) {
+            // std::stoi/stol/stof: 숫자가 아니거나 범위를 벗어난 값
+            std::cerr << "잘못된 값: " << arg << " " << value << "\n";
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (model_path.empty() || tokenizer_path.empty() || manifest_path.empty()) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<BatchItem> items;
+    if (!LoadManifest(manifest_path, items)) {
+        return 1;
+    }
+
+    std::ofstream output_file;
+    if (!output_path.empty()) {
+        output_file.open(output_path);
+        if (!output_file) {
+            std::cerr << "출력 파일을 열 수 없습니다: " << output_path << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = output_path.empty() ? std::cout : output_file;
+
+    // 모델은 한 번만 로드하고 모든 작업이 공유한다
+    std::shared_ptr<Wav2VecCTCOnnxCore> engine;
+    try {
+        engine = std::make_shared<Wav2VecCTCOnnxCore>(model_path, tokenizer_path, device);
+    } catch (const std::exception& e) {
+        std::cerr << "모델 로드 실패: " << e.what() << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<std::string>> results;
+    results.reserve(items.size());
+    if (long_form) {
+        // 장문은 파일을 하나씩 처리하고 파일 내부 세그먼트를 스레드 풀에서 병렬 추론한다
+        for (const auto& item : items) {
+            nlohmann::json line;
+            line["audio"] = item.audio_path;
+            line["sentence"] = item.sentence;
+            try {
+                EngineCoordinator coordinator(engine, 0.3f, confidence_threshold);
+                auto result = coordinator.EvaluateLongForm(item.sentence, item.audio_path, num_threads);
+                line["evaluation"] = ResultMapToJson(result);
+            } catch (const std::exception& e) {
+                line["error"] = e.what();
+            }
+            out << line.dump() << "\n";
+        }
+    } else {
+        ThreadPool pool(std::min(num_threads, std::max<size_t>(1, items.size())));
+
+        for (const auto& item : items) {
+            results.push_back(pool.Submit([engine, item, confidence_threshold, chunked]() {
+                nlohmann::json line;
+                line["audio"] = item.audio_path;
+                line["sentence"] = item.sentence;
+                try {
+                    EngineCoordinator coordinator(engine, 0.3f, confidence_threshold);
+                    auto result = coordinator.EvaluateFile(item.sentence, item.audio_path, chunked);
+                    line["evaluation"] = ResultMapToJson(result);
+                } catch (const std::exception& e) {
+                    line["error"] = e.what();
+                }
+                return line.dump();
+            }));
+        }
+
+        // 입력 순서대로 기록 (완료 순서와 무관하게 결정적인 출력)
+        for (auto& result : results) {
+            out << result.get() << "\n";
+        }
+    }
+    out.flush();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << items.size() << "개 파일 평가 완료 (" << elapsed << "초, 스레드 " << num_threads << ")\n";
+
+    return 0;
+}